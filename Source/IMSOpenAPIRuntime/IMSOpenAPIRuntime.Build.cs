@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Code shared by the generated IMS OpenAPI modules
+public class IMSOpenAPIRuntime : ModuleRules
+{
+	public IMSOpenAPIRuntime(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicDependencyModuleNames.AddRange(
+			new string[] {
+				"Core",
+				"Http",
+				"Json",
+			}
+		);
+
+		PCHUsage = PCHUsageMode.NoPCHs;
+	}
+}
@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIBase64.h"
+
+namespace IMSOpenAPI
+{
+
+namespace
+{
+	const ANSICHAR Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	/* Characters encoding each 12 bits value, so that three bytes are encoded with two lookups */
+	struct FEncodeTable
+	{
+		TCHAR Pairs[4096][2];
+
+		FEncodeTable()
+		{
+			for (int32 Value = 0; Value < 4096; ++Value)
+			{
+				Pairs[Value][0] = Alphabet[Value >> 6];
+				Pairs[Value][1] = Alphabet[Value & 0x3F];
+			}
+		}
+	};
+
+	/* Value of each character, with the high bit set for characters outside of both alphabets */
+	struct FDecodeTable
+	{
+		uint8 Values[256];
+
+		FDecodeTable()
+		{
+			FMemory::Memset(Values, 0x80, sizeof(Values));
+			for (int32 Index = 0; Index < 64; ++Index)
+			{
+				Values[static_cast<uint8>(Alphabet[Index])] = static_cast<uint8>(Index);
+			}
+			Values['+'] = 62;
+			Values['/'] = 63;
+		}
+	};
+
+	const FEncodeTable& GetEncodeTable()
+	{
+		static const FEncodeTable Table;
+		return Table;
+	}
+
+	const FDecodeTable& GetDecodeTable()
+	{
+		static const FDecodeTable Table;
+		return Table;
+	}
+
+	template<typename CharType>
+	FORCEINLINE uint32 DecodeChar(const uint8 (&Values)[256], CharType Char, uint32& InOutInvalid)
+	{
+		// Wide characters are out of the table, they are mapped to an invalid entry
+		const uint32 Index = static_cast<uint32>(Char);
+		const uint8 Value = Values[Index < 256 ? Index : 0];
+		InOutInvalid |= Value | (Index < 256 ? 0 : 0x80);
+		return Value;
+	}
+
+	template<typename CharType>
+	bool Decode(const CharType* Source, int32 Length, TArray<uint8>& OutBytes)
+	{
+		while (Length > 0 && Source[Length - 1] == '=')
+		{
+			--Length;
+		}
+
+		const int32 NumBlocks = Length / 4;
+		const int32 NumTailChars = Length % 4;
+		if (NumTailChars == 1)
+			return false;
+
+		OutBytes.SetNumUninitialized(NumBlocks * 3 + (NumTailChars > 0 ? NumTailChars - 1 : 0), false);
+		uint8* Destination = OutBytes.GetData();
+
+		const uint8 (&Values)[256] = GetDecodeTable().Values;
+
+		// Invalid characters are accumulated and checked once at the end
+		uint32 Invalid = 0;
+		for (int32 Block = 0; Block < NumBlocks; ++Block, Source += 4, Destination += 3)
+		{
+			const uint32 Bits = (DecodeChar(Values, Source[0], Invalid) << 18)
+				| (DecodeChar(Values, Source[1], Invalid) << 12)
+				| (DecodeChar(Values, Source[2], Invalid) << 6)
+				| DecodeChar(Values, Source[3], Invalid);
+
+			Destination[0] = static_cast<uint8>(Bits >> 16);
+			Destination[1] = static_cast<uint8>(Bits >> 8);
+			Destination[2] = static_cast<uint8>(Bits);
+		}
+
+		if (NumTailChars > 0)
+		{
+			uint32 Bits = (DecodeChar(Values, Source[0], Invalid) << 18) | (DecodeChar(Values, Source[1], Invalid) << 12);
+			Destination[0] = static_cast<uint8>(Bits >> 16);
+			if (NumTailChars == 3)
+			{
+				Bits |= DecodeChar(Values, Source[2], Invalid) << 6;
+				Destination[1] = static_cast<uint8>(Bits >> 8);
+			}
+		}
+
+		if (Invalid & 0x80)
+		{
+			OutBytes.Reset();
+			return false;
+		}
+		return true;
+	}
+}
+
+FString Base64UrlEncode(const uint8* Source, int32 Length)
+{
+	FString Result;
+	if (Length <= 0)
+		return Result;
+
+	const int32 EncodedLength = ((Length + 2) / 3) * 4;
+	TArray<TCHAR>& Chars = Result.GetCharArray();
+	Chars.SetNumUninitialized(EncodedLength + 1);
+	TCHAR* Destination = Chars.GetData();
+
+	const TCHAR (*Pairs)[2] = GetEncodeTable().Pairs;
+
+	const int32 NumBlocks = Length / 3;
+	for (int32 Block = 0; Block < NumBlocks; ++Block, Source += 3, Destination += 4)
+	{
+		const uint32 Bits = (static_cast<uint32>(Source[0]) << 16) | (static_cast<uint32>(Source[1]) << 8) | Source[2];
+		FMemory::Memcpy(Destination, Pairs[Bits >> 12], 2 * sizeof(TCHAR));
+		FMemory::Memcpy(Destination + 2, Pairs[Bits & 0xFFF], 2 * sizeof(TCHAR));
+	}
+
+	const int32 NumTailBytes = Length - NumBlocks * 3;
+	if (NumTailBytes > 0)
+	{
+		const uint32 Bits = (static_cast<uint32>(Source[0]) << 16) | (NumTailBytes == 2 ? static_cast<uint32>(Source[1]) << 8 : 0);
+		Destination[0] = Alphabet[Bits >> 18];
+		Destination[1] = Alphabet[(Bits >> 12) & 0x3F];
+		Destination[2] = NumTailBytes == 2 ? Alphabet[(Bits >> 6) & 0x3F] : TEXT('=');
+		Destination[3] = TEXT('=');
+		Destination += 4;
+	}
+
+	*Destination = TEXT('\0');
+	return Result;
+}
+
+bool Base64UrlDecode(const TCHAR* Source, int32 Length, TArray<uint8>& OutBytes)
+{
+	return Decode(Source, Length, OutBytes);
+}
+
+bool Base64UrlDecode(const ANSICHAR* Source, int32 Length, TArray<uint8>& OutBytes)
+{
+	// Characters above 0x7F are out of the table as well
+	return Decode(reinterpret_cast<const uint8*>(Source), Length, OutBytes);
+}
+
+}
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPICancellation.h"
+
+namespace IMSOpenAPI
+{
+
+FCancellationToken::FCancellationToken()
+	: bCancelled(false)
+{
+}
+
+FCancellationToken::~FCancellationToken()
+{
+	Cancel();
+}
+
+void FCancellationToken::CancelRequest(const FHttpRequestRef& HttpRequest)
+{
+	HttpRequest->OnProcessRequestComplete().Unbind();
+	HttpRequest->CancelRequest();
+}
+
+void FCancellationToken::Cancel()
+{
+	TArray<TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>> CancelledRequests;
+	{
+		FScopeLock Lock(&CriticalSection);
+		bCancelled = true;
+		CancelledRequests = MoveTemp(Requests);
+	}
+
+	for (const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>& WeakRequest : CancelledRequests)
+	{
+		if (FHttpRequestPtr HttpRequest = WeakRequest.Pin())
+		{
+			CancelRequest(HttpRequest.ToSharedRef());
+		}
+	}
+}
+
+bool FCancellationToken::IsCancelled() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return bCancelled;
+}
+
+bool FCancellationToken::Register(const FHttpRequestRef& HttpRequest)
+{
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (!bCancelled)
+		{
+			// Long-lived tokens see many requests, the ones that completed since are dropped
+			Requests.RemoveAllSwap([](const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>& WeakRequest)
+			{
+				const FHttpRequestPtr Request = WeakRequest.Pin();
+				return !Request.IsValid() || Request->GetStatus() == EHttpRequestStatus::Succeeded || Request->GetStatus() == EHttpRequestStatus::Failed
+					|| Request->GetStatus() == EHttpRequestStatus::Failed_ConnectionError;
+			}, false);
+
+			Requests.Add(HttpRequest);
+			return true;
+		}
+	}
+
+	CancelRequest(HttpRequest);
+	return false;
+}
+
+}
@@ -0,0 +1,148 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIHttpBodyStream.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "OpenAPIInstrumentation.h"
+
+namespace IMSOpenAPI
+{
+
+FHttpBodyStream::FHttpBodyStream()
+	: Size(0)
+	, NumFiles(0)
+	, Position(0)
+	, SegmentIndex(0)
+	, FileSegmentIndex(INDEX_NONE)
+{
+	SetIsLoading(true);
+}
+
+FHttpBodyStream::~FHttpBodyStream()
+{
+}
+
+void FHttpBodyStream::AppendBytes(const uint8* Data, int64 Num)
+{
+	if (Num <= 0)
+		return;
+
+	if (Segments.Num() == 0 || !Segments.Last().FilePath.IsEmpty())
+	{
+		FSegment& Segment = Segments.AddDefaulted_GetRef();
+		Segment.Offset = Size;
+	}
+
+	FSegment& Segment = Segments.Last();
+	Segment.Bytes.Append(Data, Num);
+	Segment.Size += Num;
+	Size += Num;
+}
+
+void FHttpBodyStream::AppendUtf8(const FString& String)
+{
+	FTCHARToUTF8 Converted(*String, String.Len());
+	AppendBytes(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+}
+
+bool FHttpBodyStream::AppendFile(const FString& FilePath)
+{
+	const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+	if (FileSize < 0)
+		return false;
+
+	FSegment& Segment = Segments.AddDefaulted_GetRef();
+	Segment.Offset = Size;
+	Segment.Size = FileSize;
+	Segment.FilePath = FilePath;
+
+	Size += FileSize;
+	++NumFiles;
+	return true;
+}
+
+TArray<uint8> FHttpBodyStream::ReleaseBytes()
+{
+	check(NumFiles == 0);
+
+	TArray<uint8> Bytes = Segments.Num() > 0 ? MoveTemp(Segments[0].Bytes) : TArray<uint8>();
+	Segments.Reset();
+	Size = 0;
+	Position = 0;
+	SegmentIndex = 0;
+	return Bytes;
+}
+
+void FHttpBodyStream::Seek(int64 InPosition)
+{
+	// Requests rewind their body when they are sent again
+	Position = FMath::Clamp<int64>(InPosition, 0, Size);
+	SegmentIndex = 0;
+}
+
+bool FHttpBodyStream::ReadFile(int32 InSegmentIndex, int64 SegmentPosition, uint8* Data, int64 Num)
+{
+	const FSegment& Segment = Segments[InSegmentIndex];
+	if (FileSegmentIndex != InSegmentIndex)
+	{
+		FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Segment.FilePath));
+		FileSegmentIndex = FileHandle.IsValid() ? InSegmentIndex : INDEX_NONE;
+		if (!FileHandle.IsValid())
+		{
+			UE_LOG(LogIMSOpenAPI, Error, TEXT("Failed to open file (%s)"), *Segment.FilePath);
+			return false;
+		}
+	}
+
+	if (FileHandle->Tell() != SegmentPosition && !FileHandle->Seek(SegmentPosition))
+		return false;
+
+	return FileHandle->Read(Data, Num);
+}
+
+void FHttpBodyStream::Serialize(void* Data, int64 Num)
+{
+	uint8* Destination = static_cast<uint8*>(Data);
+	if (Position + Num > Size)
+	{
+		SetError();
+		return;
+	}
+
+	while (Num > 0)
+	{
+		while (Position >= Segments[SegmentIndex].Offset + Segments[SegmentIndex].Size)
+		{
+			++SegmentIndex;
+		}
+
+		const FSegment& Segment = Segments[SegmentIndex];
+		const int64 SegmentPosition = Position - Segment.Offset;
+		const int64 NumRead = FMath::Min(Num, Segment.Size - SegmentPosition);
+
+		if (Segment.FilePath.IsEmpty())
+		{
+			FMemory::Memcpy(Destination, Segment.Bytes.GetData() + SegmentPosition, NumRead);
+		}
+		else if (!ReadFile(SegmentIndex, SegmentPosition, Destination, NumRead))
+		{
+			// The file changed since it was appended, the request fails rather than sending a truncated body
+			SetError();
+			return;
+		}
+
+		Destination += NumRead;
+		Position += NumRead;
+		Num -= NumRead;
+	}
+
+	// Files are closed once read
+	if (FileSegmentIndex != INDEX_NONE && Position >= Segments[FileSegmentIndex].Offset + Segments[FileSegmentIndex].Size)
+	{
+		FileHandle.Reset();
+		FileSegmentIndex = INDEX_NONE;
+	}
+}
+
+}
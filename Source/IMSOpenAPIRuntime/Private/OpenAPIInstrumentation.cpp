@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIInstrumentation.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogIMSOpenAPI);
+
+DEFINE_STAT(STAT_IMS_DecodeResponse);
+DEFINE_STAT(STAT_IMS_Responses);
+DEFINE_STAT(STAT_IMS_FailedResponses);
+DEFINE_STAT(STAT_IMS_Retries);
+DEFINE_STAT(STAT_IMS_BytesSent);
+DEFINE_STAT(STAT_IMS_BytesReceived);
+
+CSV_DEFINE_CATEGORY_MODULE(IMSOPENAPIRUNTIME_API, IMS, true);
+
+static FAutoConsoleCommand IMSApiStatsCmd(
+	TEXT("ims.Api.Stats"),
+	TEXT("Logs the latency percentiles, retries, response sizes and decode times of each IMS API operation"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		IMSOpenAPI::FInstrumentation::Get().DumpStats();
+	}));
+
+static FAutoConsoleCommand IMSApiResetStatsCmd(
+	TEXT("ims.Api.ResetStats"),
+	TEXT("Resets the counters logged by ims.Api.Stats"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		IMSOpenAPI::FInstrumentation::Get().ResetStats();
+	}));
+
+namespace IMSOpenAPI
+{
+
+FLatencyHistogram::FLatencyHistogram()
+{
+	Reset();
+}
+
+void FLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Counts);
+	TotalCount = 0;
+	TotalMicros = 0;
+	MaxMicros = 0;
+}
+
+int32 FLatencyHistogram::GetBucketIndex(uint64 Micros)
+{
+	if (Micros < SubBucketCount)
+		return static_cast<int32>(Micros);
+
+	// The highest SubBucketBits + 1 bits select the bucket, the lower ones are the error
+	const int32 HighestBit = static_cast<int32>(FMath::FloorLog2_64(Micros));
+	if (HighestBit >= MaxValueBits)
+		return NumBuckets - 1;
+
+	const int32 Shift = HighestBit - SubBucketBits;
+	return (Shift + 1) * SubBucketCount + static_cast<int32>(Micros >> Shift) - SubBucketCount;
+}
+
+uint64 FLatencyHistogram::GetBucketValue(int32 Index)
+{
+	if (Index < SubBucketCount)
+		return Index;
+
+	const int32 Shift = Index / SubBucketCount - 1;
+	const uint64 LowestValue = static_cast<uint64>(Index % SubBucketCount + SubBucketCount) << Shift;
+	return LowestValue + (1ull << Shift) - 1;
+}
+
+void FLatencyHistogram::Record(double Seconds)
+{
+	const uint64 Micros = static_cast<uint64>(FMath::Max(0.0, Seconds) * 1e6);
+
+	++Counts[GetBucketIndex(Micros)];
+	++TotalCount;
+	TotalMicros += Micros;
+	MaxMicros = FMath::Max(MaxMicros, Micros);
+}
+
+double FLatencyHistogram::GetPercentileSeconds(double Percentile) const
+{
+	if (TotalCount == 0)
+		return 0.0;
+
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * TotalCount)));
+
+	uint64 Count = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Count += Counts[Index];
+		if (Count >= Rank)
+		{
+			// The bucket bound can be above anything that was recorded
+			return FMath::Min(GetBucketValue(Index), MaxMicros) * 1e-6;
+		}
+	}
+
+	return GetMaxSeconds();
+}
+
+FInstrumentation& FInstrumentation::Get()
+{
+	static FInstrumentation Instrumentation;
+	return Instrumentation;
+}
+
+FInstrumentation::FOperation& FInstrumentation::FindOrAddOperation(const TCHAR* Operation)
+{
+	const FName OperationName(Operation);
+	if (FOperation* Existing = Operations.Find(OperationName))
+		return *Existing;
+
+	FOperation& Added = Operations.Add(OperationName);
+	Added.CsvLatencyStat = FName(*FString::Printf(TEXT("%s_LatencyMs"), Operation));
+	Added.CsvDecodeTimeStat = FName(*FString::Printf(TEXT("%s_DecodeMs"), Operation));
+	return Added;
+}
+
+void FInstrumentation::RecordResponse(const TCHAR* Operation, const FHttpRequestPtr& HttpRequest, const FHttpResponsePtr& HttpResponse, bool bSuccessful, double DecodeSeconds)
+{
+	const double LatencySeconds = HttpRequest.IsValid() ? HttpRequest->GetElapsedTime() : 0.0;
+	const int32 BytesSent = HttpRequest.IsValid() ? HttpRequest->GetContent().Num() : 0;
+	const int32 BytesReceived = HttpResponse.IsValid() ? HttpResponse->GetContent().Num() : 0;
+
+	INC_DWORD_STAT(STAT_IMS_Responses);
+	INC_DWORD_STAT_BY(STAT_IMS_FailedResponses, bSuccessful ? 0 : 1);
+	INC_DWORD_STAT_BY(STAT_IMS_BytesSent, BytesSent);
+	INC_DWORD_STAT_BY(STAT_IMS_BytesReceived, BytesReceived);
+
+	FScopeLock Lock(&CriticalSection);
+
+	FOperation& Entry = FindOrAddOperation(Operation);
+	FOperationStats& Stats = Entry.Stats;
+	Stats.Latency.Record(LatencySeconds);
+	Stats.DecodeTime.Record(DecodeSeconds);
+	++Stats.Responses;
+	Stats.Failures += bSuccessful ? 0 : 1;
+	Stats.BytesSent += BytesSent;
+	Stats.BytesReceived += BytesReceived;
+	Stats.MaxResponseBytes = FMath::Max(Stats.MaxResponseBytes, BytesReceived);
+
+#if CSV_PROFILER
+	// Responses complete off the game thread, the stats are attributed to the frame being captured
+	FCsvProfiler::RecordCustomStat(Entry.CsvLatencyStat, CSV_CATEGORY_INDEX(IMS), static_cast<float>(LatencySeconds * 1000.0), ECsvCustomStatOp::Max);
+	FCsvProfiler::RecordCustomStat(Entry.CsvDecodeTimeStat, CSV_CATEGORY_INDEX(IMS), static_cast<float>(DecodeSeconds * 1000.0), ECsvCustomStatOp::Accumulate);
+#endif
+	CSV_CUSTOM_STAT(IMS, Responses, 1, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(IMS, BytesReceived, BytesReceived, ECsvCustomStatOp::Accumulate);
+}
+
+void FInstrumentation::RecordRetry(const TCHAR* Operation)
+{
+	INC_DWORD_STAT(STAT_IMS_Retries);
+	CSV_CUSTOM_STAT(IMS, Retries, 1, ECsvCustomStatOp::Accumulate);
+
+	FScopeLock Lock(&CriticalSection);
+	++FindOrAddOperation(Operation).Stats.Retries;
+}
+
+TMap<FName, FOperationStats> FInstrumentation::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	TMap<FName, FOperationStats> Stats;
+	for (const TPair<FName, FOperation>& Operation : Operations)
+	{
+		Stats.Add(Operation.Key, Operation.Value.Stats);
+	}
+	return Stats;
+}
+
+void FInstrumentation::DumpStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	for (const TPair<FName, FOperation>& Operation : Operations)
+	{
+		const FOperationStats& Stats = Operation.Value.Stats;
+		UE_LOG(LogIMSOpenAPI, Display, TEXT("%s: Responses = %llu, Failures = %llu, Retries = %llu, Latency p50/p95/p99/max = %.1f/%.1f/%.1f/%.1f ms, Decode p50/p99 = %.3f/%.3f ms, Bytes sent/received = %llu/%llu, MaxResponseBytes = %d"),
+			*Operation.Key.ToString(), Stats.Responses, Stats.Failures, Stats.Retries,
+			Stats.Latency.GetPercentileSeconds(50.0) * 1000.0, Stats.Latency.GetPercentileSeconds(95.0) * 1000.0, Stats.Latency.GetPercentileSeconds(99.0) * 1000.0, Stats.Latency.GetMaxSeconds() * 1000.0,
+			Stats.DecodeTime.GetPercentileSeconds(50.0) * 1000.0, Stats.DecodeTime.GetPercentileSeconds(99.0) * 1000.0,
+			Stats.BytesSent, Stats.BytesReceived, Stats.MaxResponseBytes);
+	}
+}
+
+void FInstrumentation::ResetStats()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	for (TPair<FName, FOperation>& Operation : Operations)
+	{
+		Operation.Value.Stats = FOperationStats();
+	}
+}
+
+}
@@ -0,0 +1,507 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIBase64.h"
+#include "OpenAPIFieldTable.h"
+
+namespace IMSOpenAPI
+{
+
+namespace
+{
+	void AppendUtf8(TArray<ANSICHAR>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add(static_cast<ANSICHAR>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	bool ReadHex4(const ANSICHAR* Data, int32 Size, int32& Position, uint32& OutValue)
+	{
+		if (Position + 4 > Size)
+		{
+			return false;
+		}
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const ANSICHAR C = Data[Position++];
+			uint32 Digit;
+			if (C >= '0' && C <= '9')
+			{
+				Digit = C - '0';
+			}
+			else if (C >= 'a' && C <= 'f')
+			{
+				Digit = C - 'a' + 10;
+			}
+			else if (C >= 'A' && C <= 'F')
+			{
+				Digit = C - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+			OutValue = (OutValue << 4) | Digit;
+		}
+		return true;
+	}
+
+	bool IsNumberChar(ANSICHAR C)
+	{
+		return (C >= '0' && C <= '9') || C == '-' || C == '+' || C == '.' || C == 'e' || C == 'E';
+	}
+}
+
+JsonStreamReader::JsonStreamReader(const uint8* InData, int32 InSize)
+	: Data(reinterpret_cast<const ANSICHAR*>(InData))
+	, Size(InSize)
+	, Position(0)
+	, bError(false)
+	, Key(nullptr)
+	, KeyLength(0)
+{
+	// Skip the UTF-8 byte order mark
+	if (Size >= 3 && static_cast<uint8>(Data[0]) == 0xEF && static_cast<uint8>(Data[1]) == 0xBB && static_cast<uint8>(Data[2]) == 0xBF)
+	{
+		Position = 3;
+	}
+}
+
+void JsonStreamReader::SkipWhitespace()
+{
+	while (Position < Size && (Data[Position] == ' ' || Data[Position] == '\t' || Data[Position] == '\n' || Data[Position] == '\r'))
+	{
+		++Position;
+	}
+}
+
+bool JsonStreamReader::Fail()
+{
+	bError = true;
+	return false;
+}
+
+ANSICHAR JsonStreamReader::Peek()
+{
+	SkipWhitespace();
+	return Position < Size ? Data[Position] : '\0';
+}
+
+bool JsonStreamReader::ReadObjectStart()
+{
+	if (bError)
+		return false;
+
+	if (Peek() != '{')
+	{
+		SkipValue();
+		return false;
+	}
+
+	++Position;
+	ContainerHasItems.Push(false);
+	return true;
+}
+
+bool JsonStreamReader::ReadArrayStart()
+{
+	if (bError)
+		return false;
+
+	if (Peek() != '[')
+	{
+		SkipValue();
+		return false;
+	}
+
+	++Position;
+	ContainerHasItems.Push(false);
+	return true;
+}
+
+bool JsonStreamReader::NextItem(ANSICHAR EndChar)
+{
+	if (bError || ContainerHasItems.Num() == 0)
+		return false;
+
+	ANSICHAR C = Peek();
+	if (C == EndChar)
+	{
+		++Position;
+		ContainerHasItems.Pop(false);
+		return false;
+	}
+
+	if (ContainerHasItems.Last())
+	{
+		if (C != ',')
+			return Fail();
+
+		++Position;
+		if (Peek() == EndChar)
+			return Fail();
+	}
+
+	ContainerHasItems.Last() = true;
+	return true;
+}
+
+bool JsonStreamReader::NextField()
+{
+	if (!NextItem('}'))
+		return false;
+
+	if (Peek() != '"' || !ReadRawString(Key, KeyLength, KeyScratch))
+		return Fail();
+
+	if (Peek() != ':')
+		return Fail();
+
+	++Position;
+	return true;
+}
+
+bool JsonStreamReader::NextElement()
+{
+	return NextItem(']');
+}
+
+bool JsonStreamReader::IsKey(const ANSICHAR* InKey) const
+{
+	return FCStringAnsi::Strlen(InKey) == KeyLength && FMemory::Memcmp(Key, InKey, KeyLength) == 0;
+}
+
+FString JsonStreamReader::GetKey() const
+{
+	if (KeyLength == 0)
+		return FString();
+
+	FUTF8ToTCHAR Converted(Key, KeyLength);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+uint32 JsonStreamReader::GetKeyHash() const
+{
+	return HashFieldName(Key, KeyLength);
+}
+
+bool JsonStreamReader::ReadRawString(const ANSICHAR*& OutString, int32& OutLength, TArray<ANSICHAR>& Scratch)
+{
+	// Skip the opening quote
+	++Position;
+	const int32 Start = Position;
+
+	// Strings without escape sequences are used in place
+	while (Position < Size)
+	{
+		const ANSICHAR C = Data[Position];
+		if (C == '"')
+		{
+			OutString = Data + Start;
+			OutLength = Position - Start;
+			++Position;
+			return true;
+		}
+		else if (C == '\\')
+		{
+			break;
+		}
+		else if (static_cast<uint8>(C) < 0x20)
+		{
+			return Fail();
+		}
+		++Position;
+	}
+
+	Scratch.Reset();
+	Scratch.Append(Data + Start, Position - Start);
+
+	while (Position < Size)
+	{
+		ANSICHAR C = Data[Position++];
+		if (C == '"')
+		{
+			OutString = Scratch.GetData();
+			OutLength = Scratch.Num();
+			return true;
+		}
+		else if (static_cast<uint8>(C) < 0x20)
+		{
+			return Fail();
+		}
+		else if (C != '\\')
+		{
+			Scratch.Add(C);
+			continue;
+		}
+
+		if (Position >= Size)
+			return Fail();
+
+		C = Data[Position++];
+		switch (C)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			Scratch.Add(C);
+			break;
+		case 'b':
+			Scratch.Add('\b');
+			break;
+		case 'f':
+			Scratch.Add('\f');
+			break;
+		case 'n':
+			Scratch.Add('\n');
+			break;
+		case 'r':
+			Scratch.Add('\r');
+			break;
+		case 't':
+			Scratch.Add('\t');
+			break;
+		case 'u':
+		{
+			uint32 CodePoint;
+			if (!ReadHex4(Data, Size, Position, CodePoint))
+				return Fail();
+
+			// Characters outside of the basic multilingual plane are escaped as a surrogate pair
+			if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+			{
+				uint32 LowSurrogate;
+				if (Position + 2 > Size || Data[Position] != '\\' || Data[Position + 1] != 'u')
+					return Fail();
+
+				Position += 2;
+				if (!ReadHex4(Data, Size, Position, LowSurrogate) || LowSurrogate < 0xDC00 || LowSurrogate > 0xDFFF)
+					return Fail();
+
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+			}
+
+			AppendUtf8(Scratch, CodePoint);
+			break;
+		}
+		default:
+			return Fail();
+		}
+	}
+
+	return Fail();
+}
+
+bool JsonStreamReader::ReadRawNumber(ANSICHAR* OutBuffer, int32 BufferSize)
+{
+	const int32 Start = Position;
+	while (Position < Size && IsNumberChar(Data[Position]))
+	{
+		++Position;
+	}
+
+	const int32 Length = Position - Start;
+	if (Length == 0 || Length >= BufferSize)
+		return Fail();
+
+	FMemory::Memcpy(OutBuffer, Data + Start, Length);
+	OutBuffer[Length] = '\0';
+	return true;
+}
+
+bool JsonStreamReader::ReadString(FString& OutValue)
+{
+	if (bError)
+		return false;
+
+	if (Peek() != '"')
+	{
+		SkipValue();
+		return false;
+	}
+
+	const ANSICHAR* String;
+	int32 Length;
+	if (!ReadRawString(String, Length, StringScratch))
+		return false;
+
+	if (Length == 0)
+	{
+		OutValue.Reset();
+		return true;
+	}
+
+	// Assigned in place so that a string decoded again keeps its allocation
+	FUTF8ToTCHAR Converted(String, Length);
+	OutValue.Reset(Converted.Length());
+	OutValue.AppendChars(Converted.Get(), Converted.Length());
+	return true;
+}
+
+bool JsonStreamReader::ReadBase64Url(TArray<uint8>& OutValue)
+{
+	if (bError)
+		return false;
+
+	if (Peek() != '"')
+	{
+		SkipValue();
+		return false;
+	}
+
+	// The Base64Url alphabet is ASCII, there is no need to convert the string first
+	const ANSICHAR* String;
+	int32 Length;
+	if (!ReadRawString(String, Length, StringScratch))
+		return false;
+
+	return Base64UrlDecode(String, Length, OutValue);
+}
+
+bool JsonStreamReader::ReadNumber(double& OutValue)
+{
+	if (bError)
+		return false;
+
+	const ANSICHAR C = Peek();
+	if (C != '-' && (C < '0' || C > '9'))
+	{
+		SkipValue();
+		return false;
+	}
+
+	ANSICHAR Buffer[64];
+	if (!ReadRawNumber(Buffer, UE_ARRAY_COUNT(Buffer)))
+		return false;
+
+	OutValue = FCStringAnsi::Atod(Buffer);
+	return true;
+}
+
+bool JsonStreamReader::ReadInt32(int32& OutValue)
+{
+	double Value;
+	if (!ReadNumber(Value) || Value < MIN_int32 || Value > MAX_int32)
+		return false;
+
+	OutValue = static_cast<int32>(FMath::RoundHalfFromZero(Value));
+	return true;
+}
+
+bool JsonStreamReader::ReadInt64(int64& OutValue)
+{
+	double Value;
+	if (!ReadNumber(Value) || Value < static_cast<double>(MIN_int64) || Value > static_cast<double>(MAX_int64))
+		return false;
+
+	OutValue = static_cast<int64>(FMath::RoundHalfFromZero(Value));
+	return true;
+}
+
+bool JsonStreamReader::MatchLiteral(const ANSICHAR* Literal, int32 Length)
+{
+	if (Position + Length > Size || FCStringAnsi::Strncmp(Data + Position, Literal, Length) != 0)
+		return false;
+
+	Position += Length;
+	return true;
+}
+
+bool JsonStreamReader::ReadBool(bool& OutValue)
+{
+	if (bError)
+		return false;
+
+	const ANSICHAR C = Peek();
+	if (C == 't' || C == 'f')
+	{
+		OutValue = C == 't';
+		return OutValue ? (MatchLiteral("true", 4) || Fail()) : (MatchLiteral("false", 5) || Fail());
+	}
+
+	SkipValue();
+	return false;
+}
+
+bool JsonStreamReader::TryReadNull()
+{
+	if (bError || Peek() != 'n')
+		return false;
+
+	return MatchLiteral("null", 4) || Fail();
+}
+
+bool JsonStreamReader::SkipValue()
+{
+	if (bError)
+		return false;
+
+	const ANSICHAR C = Peek();
+	switch (C)
+	{
+	case '{':
+		++Position;
+		ContainerHasItems.Push(false);
+		while (NextField())
+		{
+			if (!SkipValue())
+				return false;
+		}
+		return !bError;
+	case '[':
+		++Position;
+		ContainerHasItems.Push(false);
+		while (NextElement())
+		{
+			if (!SkipValue())
+				return false;
+		}
+		return !bError;
+	case '"':
+	{
+		const ANSICHAR* String;
+		int32 Length;
+		return ReadRawString(String, Length, StringScratch);
+	}
+	case 't':
+		return MatchLiteral("true", 4) || Fail();
+	case 'f':
+		return MatchLiteral("false", 5) || Fail();
+	case 'n':
+		return MatchLiteral("null", 4) || Fail();
+	default:
+		if (C == '-' || (C >= '0' && C <= '9'))
+		{
+			while (Position < Size && IsNumberChar(Data[Position]))
+			{
+				++Position;
+			}
+			return true;
+		}
+		return Fail();
+	}
+}
+
+}
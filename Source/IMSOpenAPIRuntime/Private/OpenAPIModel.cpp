@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIModel.h"
+#include "OpenAPIJsonStreamReader.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace IMSOpenAPI
+{
+
+bool HttpRetryManager::Tick(float DeltaTime)
+{
+	FManager::Update();
+	return true;
+}
+
+TSharedRef<HttpRetryManager> HttpRetryManager::GetShared()
+{
+	static FCriticalSection CriticalSection;
+	FScopeLock Lock(&CriticalSection);
+
+	// Released with the last API using it rather than at exit, after the ticker it is registered with may be gone
+	static TWeakPtr<HttpRetryManager> SharedManager;
+	TSharedPtr<HttpRetryManager> Manager = SharedManager.Pin();
+	if (!Manager.IsValid())
+	{
+		Manager = MakeShared<HttpRetryManager>(6, 60);
+		SharedManager = Manager;
+	}
+	return Manager.ToSharedRef();
+}
+
+HttpRetryParams::HttpRetryParams(const FHttpRetrySystem::FRetryLimitCountSetting& InRetryLimitCountOverride /*= FRetryLimitCountSetting()*/,
+    const FHttpRetrySystem::FRetryTimeoutRelativeSecondsSetting& InRetryTimeoutRelativeSecondsOverride /*= FRetryTimeoutRelativeSecondsSetting()*/,
+    const FHttpRetrySystem::FRetryResponseCodes& InRetryResponseCodes /*= FRetryResponseCodes()*/,
+    const FHttpRetrySystem::FRetryVerbs& InRetryVerbs /*= FRetryVerbs()*/,
+    const FHttpRetrySystem::FRetryDomainsPtr& InRetryDomains /*= FRetryDomainsPtr() */)
+    : RetryLimitCountOverride(InRetryLimitCountOverride)
+    , RetryTimeoutRelativeSecondsOverride(InRetryTimeoutRelativeSecondsOverride)
+    , RetryResponseCodes(InRetryResponseCodes)
+    , RetryVerbs(InRetryVerbs)
+    , RetryDomains(InRetryDomains)
+{
+}
+
+bool Model::FromJsonStream(JsonStreamReader& Reader)
+{
+	Reader.SkipValue();
+	return false;
+}
+
+FString Request::ComputePath() const
+{
+	TStringBuilder<256> Builder;
+	AppendPath(Builder);
+	return FString(Builder.Len(), Builder.GetData());
+}
+
+const FString& Request::ComputeUrl(const FString& BaseUrl) const
+{
+	TStringBuilder<256> Builder;
+	Builder.Append(*BaseUrl, BaseUrl.Len());
+	AppendPath(Builder);
+
+	if (CachedUrl.Len() != Builder.Len() || FCString::Strncmp(*CachedUrl, Builder.GetData(), Builder.Len()) != 0)
+	{
+		// Assigned in place to keep the allocation of the previous URL
+		CachedUrl.Reset(Builder.Len());
+		CachedUrl.AppendChars(Builder.GetData(), Builder.Len());
+	}
+	return CachedUrl;
+}
+
+bool Request::IsCancelled() const
+{
+	if (!CancellationToken.IsSet())
+		return false;
+
+	const FCancellationTokenPtr Token = CancellationToken.GetValue().Pin();
+	return !Token.IsValid() || Token->IsCancelled();
+}
+
+bool Request::HasDeadlinePassed() const
+{
+	return Deadline.IsSet() && FPlatformTime::Seconds() >= Deadline.GetValue();
+}
+
+bool Request::RegisterHttpRequest(const FHttpRequestRef& HttpRequest) const
+{
+	if (!CancellationToken.IsSet())
+		return true;
+
+	// The owner of a destroyed token is gone, so is the interest in the response
+	const FCancellationTokenPtr Token = CancellationToken.GetValue().Pin();
+	if (!Token.IsValid())
+	{
+		HttpRequest->OnProcessRequestComplete().Unbind();
+		return false;
+	}
+
+	return Token->Register(HttpRequest);
+}
+
+JsonBodyWriter::JsonBodyWriter(int32& InOutSizeHint)
+	: SizeHint(InOutSizeHint)
+	, Archive(Buffer)
+	, Writer(TJsonWriterFactory<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>::Create(&Archive))
+{
+	Buffer.Reserve(FMath::Max(SizeHint, 64));
+}
+
+void JsonBodyWriter::SetupHttpRequest(const FHttpRequestRef& HttpRequest)
+{
+	Writer->Close();
+	SizeHint = FMath::Max(SizeHint, Buffer.Num());
+	HttpRequest->SetContent(MoveTemp(Buffer));
+}
+
+FString JsonBodyWriter::ToString()
+{
+	Writer->Close();
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), Buffer.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void Response::SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode)
+{
+    ResponseCode = InHttpResponseCode;
+    SetSuccessful(EHttpResponseCodes::IsOk(InHttpResponseCode));
+    if(InHttpResponseCode == EHttpResponseCodes::RequestTimeout)
+    {
+        SetResponseString(TEXT("Request Timeout"));
+    }
+}
+
+void Response::ResetStatus()
+{
+	Successful = false;
+	ResponseCode = EHttpResponseCodes::Unknown;
+	ResponseString.Reset();
+	HttpResponse.Reset();
+}
+
+FString SingleFlightRequests::MakeKey(const TCHAR* Verb, const FString& Url, const TMap<FString, FString>& Headers)
+{
+	TStringBuilder<256> Builder;
+	Builder << Verb;
+	Builder.AppendChar(TEXT(' '));
+	Builder.Append(*Url, Url.Len());
+	for (const TPair<FString, FString>& Header : Headers)
+	{
+		Builder.AppendChar(TEXT('\n'));
+		Builder.Append(*Header.Key, Header.Key.Len());
+		Builder.AppendChar(TEXT(':'));
+		Builder.Append(*Header.Value, Header.Value.Len());
+	}
+	return FString(Builder.Len(), Builder.GetData());
+}
+
+FHttpRequestPtr SingleFlightRequests::Join(const FString& Key, FOnComplete&& OnComplete)
+{
+	Flight* InFlight = Flights.Find(Key);
+	if (!InFlight)
+		return nullptr;
+
+	InFlight->Joined.Add(MoveTemp(OnComplete));
+	return InFlight->HttpRequest;
+}
+
+void SingleFlightRequests::Add(const FString& Key, const FHttpRequestRef& HttpRequest)
+{
+	Flights.FindOrAdd(Key).HttpRequest = HttpRequest;
+}
+
+TArray<SingleFlightRequests::FOnComplete> SingleFlightRequests::Complete(const FString& Key)
+{
+	Flight InFlight;
+	Flights.RemoveAndCopyValue(Key, InFlight);
+	return MoveTemp(InFlight.Joined);
+}
+
+}
@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPIMultipartFormData.h"
+
+#include "OpenAPIInstrumentation.h"
+
+#include "Interfaces/IHttpRequest.h"
+#include "PlatformHttp.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace IMSOpenAPI
+{
+
+HttpFileInput::HttpFileInput(const TCHAR* InFilePath)
+{
+	SetFilePath(InFilePath);
+}
+
+HttpFileInput::HttpFileInput(const FString& InFilePath)
+{
+	SetFilePath(InFilePath);
+}
+
+void HttpFileInput::SetFilePath(const TCHAR* InFilePath)
+{
+	FilePath = InFilePath;
+	if(ContentType.IsEmpty())
+	{
+		ContentType = FPlatformHttp::GetMimeType(InFilePath);
+	}
+}
+
+void HttpFileInput::SetFilePath(const FString& InFilePath)
+{
+	SetFilePath(*InFilePath);
+}
+
+void HttpFileInput::SetContentType(const TCHAR* InContentType)
+{
+	ContentType = InContentType;
+}
+
+FString HttpFileInput::GetFilename() const
+{
+	return FPaths::GetCleanFilename(FilePath);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+const TCHAR* HttpMultipartFormData::Delimiter = TEXT("--");
+const TCHAR* HttpMultipartFormData::Newline = TEXT("\r\n");
+
+HttpMultipartFormData::HttpMultipartFormData()
+	: FormData(MakeShared<FHttpBodyStream, ESPMode::ThreadSafe>())
+{
+}
+
+void HttpMultipartFormData::SetBoundary(const TCHAR* InBoundary)
+{
+	checkf(Boundary.IsEmpty(), TEXT("Boundary must be set before usage"));
+	Boundary = InBoundary;
+}
+
+const FString& HttpMultipartFormData::GetBoundary() const
+{
+	if (Boundary.IsEmpty())
+	{
+		// Generate a random boundary with enough entropy, should avoid occurrences of the boundary in the data.
+		// Since the boundary is generated at every request, in case of failure, retries should succeed.
+		Boundary = FGuid::NewGuid().ToString(EGuidFormats::Short);
+	}
+
+	return Boundary;
+}
+
+void HttpMultipartFormData::SetupHttpRequest(const FHttpRequestRef& HttpRequest)
+{
+	if(HttpRequest->GetVerb() != TEXT("POST"))
+	{
+		UE_LOG(LogIMSOpenAPI, Error, TEXT("Expected POST verb when using multipart form data"));
+	}
+
+	// Append final boundary
+	AppendBoundary();
+	AppendString(Delimiter);
+
+	HttpRequest->SetHeader("Content-Type", FString::Printf(TEXT("multipart/form-data; boundary=%s"), *GetBoundary()));
+
+	// Bodies without files are sent from memory
+	if (FormData->HasFiles())
+	{
+		HttpRequest->SetContentFromStream(FormData);
+	}
+	else
+	{
+		HttpRequest->SetContent(FormData->ReleaseBytes());
+	}
+}
+
+void HttpMultipartFormData::AppendBoundary()
+{
+	if (EncodedBoundary.Num() == 0)
+	{
+		FTCHARToUTF8 Converted(*FString::Printf(TEXT("%s%s"), Delimiter, *GetBoundary()));
+		EncodedBoundary.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	FormData->AppendBytes(EncodedBoundary.GetData(), EncodedBoundary.Num());
+}
+
+void HttpMultipartFormData::AppendPartHeader(const TCHAR* Name, const TCHAR* Filename, const TCHAR* ContentType)
+{
+	AppendBoundary();
+
+	TStringBuilder<256> Header;
+	Header << Newline;
+	Header << TEXT("Content-Disposition: form-data; name=\"") << Name << TEXT("\"");
+	if (Filename)
+	{
+		Header << TEXT("; filename=\"") << Filename << TEXT("\"");
+	}
+	Header << Newline;
+	Header << TEXT("Content-Type: ") << ContentType << Newline;
+
+	// Add header to body splitter
+	Header << Newline;
+
+	AppendString(Header.ToString());
+}
+
+void HttpMultipartFormData::AddStringPart(const TCHAR* Name, const TCHAR* Data)
+{
+	AppendPartHeader(Name, nullptr, TEXT("text/plain; charset=utf-8"));
+
+	// Add Data
+	AppendString(Data);
+	AppendString(Newline);
+}
+
+void HttpMultipartFormData::AddJsonPart(const TCHAR* Name, const FString& JsonString)
+{
+	AppendPartHeader(Name, nullptr, TEXT("application/json; charset=utf-8"));
+
+	// Add Data
+	AppendString(*JsonString);
+	AppendString(Newline);
+}
+
+void HttpMultipartFormData::AddBinaryPart(const TCHAR* Name, const TArray<uint8>& ByteArray)
+{
+	AppendPartHeader(Name, nullptr, TEXT("application/octet-stream"));
+
+	// Add Data
+	FormData->AppendBytes(ByteArray.GetData(), ByteArray.Num());
+	AppendString(Newline);
+}
+
+void HttpMultipartFormData::AddFilePart(const TCHAR* Name, const HttpFileInput& File)
+{
+	if (IFileManager::Get().FileSize(*File.GetFilePath()) < 0)
+	{
+		UE_LOG(LogIMSOpenAPI, Error, TEXT("Failed to load file (%s)"), *File.GetFilePath());
+		return;
+	}
+
+	AppendPartHeader(Name, *File.GetFilename(), *File.GetContentType());
+
+	// Add Data, read while the request is sent
+	FormData->AppendFile(File.GetFilePath());
+	AppendString(Newline);
+}
+
+void HttpMultipartFormData::AppendString(const TCHAR* Str)
+{
+	FTCHARToUTF8 utf8Str(Str);
+	FormData->AppendBytes((uint8*)utf8Str.Get(), utf8Str.Length());
+}
+
+}
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OpenAPISerialization.h"
+
+namespace IMSOpenAPI
+{
+
+bool ParseDateTime(const FString& DateTimeString, FDateTime& OutDateTime)
+{
+	// Iso8601 Format: 	DateTime: YYYY-mm-ddTHH:MM:SS(.sss)(Z|+hh:mm|+hhmm|-hh:mm|-hhmm)
+	{
+		// We cannot call directly FDateTime::ParseIso8601 because it does not allow for precision beyond the millisecond, but DateTimeString might have more digits
+		int32 DotIndex;
+		FString StringToParse = DateTimeString;
+		if (DateTimeString.FindChar('.', DotIndex))
+		{
+			int32 TimeZoneIndex;
+			if (DateTimeString.FindChar('Z', TimeZoneIndex) || DateTimeString.FindChar('+', TimeZoneIndex) || DateTimeString.FindChar('-', TimeZoneIndex))
+			{
+				// The string contains a time zone designator starting at TimeZoneIndex
+				if (TimeZoneIndex > DotIndex + 4)
+				{
+					// Trim to millisecond
+					StringToParse = DateTimeString.Left(DotIndex + 4) + DateTimeString.RightChop(TimeZoneIndex);
+				}
+			}
+			else
+			{
+				// the string does not contain a time zone designator, trim it to the millisecond
+				StringToParse = DateTimeString.Left(DotIndex + 4);
+			}
+		}
+
+		if (FDateTime::ParseIso8601(*StringToParse, OutDateTime))
+			return true;
+	}
+
+	if (FDateTime::ParseHttpDate(DateTimeString, OutDateTime))
+		return true;
+
+	return FDateTime::Parse(DateTimeString, OutDateTime);
+}
+
+}
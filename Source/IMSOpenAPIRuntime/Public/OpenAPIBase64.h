@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace IMSOpenAPI
+{
+
+/*
+ * Base64Url codec, see https://en.wikipedia.org/wiki/Base64#Variants_summary_table
+ *
+ * Encodes and decodes in a single pass straight into the output, three bytes and four characters at a time through
+ * lookup tables, in place of FBase64 followed by a pass per substituted character.
+ *
+ * The encoder pads its output with '=' like FBase64. The decoder accepts padded and unpadded input, and the standard
+ * Base64 alphabet as well.
+ */
+IMSOPENAPIRUNTIME_API FString Base64UrlEncode(const uint8* Source, int32 Length);
+
+IMSOPENAPIRUNTIME_API bool Base64UrlDecode(const TCHAR* Source, int32 Length, TArray<uint8>& OutBytes);
+IMSOPENAPIRUNTIME_API bool Base64UrlDecode(const ANSICHAR* Source, int32 Length, TArray<uint8>& OutBytes);
+
+}
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+namespace IMSOpenAPI
+{
+
+/*
+ * Cancels the HTTP requests registered with it. The completion delegate of a cancelled request is unbound before the
+ * request is cancelled, so that neither the API it was issued from nor the response delegate are called back, and
+ * requests registered once the token is cancelled are cancelled right away.
+ *
+ * The generated requests only keep a weak reference to their token: an owner holding the only reference cancels its
+ * requests by releasing it, or when it is destroyed. Tokens are cancelled from the thread the requests complete on.
+ */
+class IMSOPENAPIRUNTIME_API FCancellationToken
+{
+public:
+	FCancellationToken();
+	~FCancellationToken();
+
+	void Cancel();
+	bool IsCancelled() const;
+
+	/* Adds a request about to be issued, returns false if the token was cancelled and the request with it */
+	bool Register(const FHttpRequestRef& HttpRequest);
+
+private:
+	static void CancelRequest(const FHttpRequestRef& HttpRequest);
+
+	mutable FCriticalSection CriticalSection;
+	TArray<TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>> Requests;
+	bool bCancelled;
+};
+
+typedef TSharedRef<FCancellationToken, ESPMode::ThreadSafe> FCancellationTokenRef;
+typedef TSharedPtr<FCancellationToken, ESPMode::ThreadSafe> FCancellationTokenPtr;
+typedef TWeakPtr<FCancellationToken, ESPMode::ThreadSafe> FCancellationTokenWeakPtr;
+
+inline FCancellationTokenRef MakeCancellationToken()
+{
+	return MakeShared<FCancellationToken, ESPMode::ThreadSafe>();
+}
+
+}
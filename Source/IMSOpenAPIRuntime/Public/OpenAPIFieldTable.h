@@ -0,0 +1,273 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+
+namespace IMSOpenAPI
+{
+
+/*
+ * Model field tables
+ *
+ * Each generated model lists its fields once in a static table, and the templates below decode it from a FJsonValue
+ * DOM or a JSON stream and encode it, in place of a hand-written function per model and format. Field keys are matched
+ * by their hash, computed at compile time for the table, then compared once to rule out collisions.
+ *
+ * The table is bound to the JSON helpers through a codec, see ModelFieldCodec in OpenAPISerialization.h:
+ *
+ *	struct Codec
+ *	{
+ *		typedef ... StreamReader;
+ *		typedef ... Writer;
+ *		template<typename T> static bool Read(const TSharedPtr<FJsonValue>& JsonValue, T& Value);
+ *		template<typename T> static bool Read(StreamReader& Reader, T& Value);	// Handles null and TOptional
+ *		template<typename T> static void Write(Writer& Writer, const T& Value);
+ *	};
+ *
+ * TOptional members are optional fields, every other member is a required field, as in the generated code.
+ */
+
+/* FNV-1a hash of a field key */
+constexpr uint32 HashFieldName(const ANSICHAR* Name, uint32 Hash = 2166136261u)
+{
+	return *Name ? HashFieldName(Name + 1, (Hash ^ static_cast<uint8>(*Name)) * 16777619u) : Hash;
+}
+
+inline uint32 HashFieldName(const ANSICHAR* Name, int32 Length)
+{
+	uint32 Hash = 2166136261u;
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		Hash = (Hash ^ static_cast<uint8>(Name[Index])) * 16777619u;
+	}
+	return Hash;
+}
+
+/* Keys are ASCII, other characters only have to hash differently from them */
+inline uint32 HashFieldName(const FString& Name)
+{
+	uint32 Hash = 2166136261u;
+	for (const TCHAR Char : Name)
+	{
+		Hash = (Hash ^ (Char < 0x80 ? static_cast<uint8>(Char) : 0xFFu)) * 16777619u;
+	}
+	return Hash;
+}
+
+template<typename ModelType, typename Codec>
+struct TModelField
+{
+	typedef typename Codec::StreamReader StreamReaderType;
+	typedef typename Codec::Writer WriterType;
+
+	const ANSICHAR* Name;
+	const TCHAR* WideName;
+	uint32 Hash;
+	bool bRequired;
+
+	bool (*ReadValue)(ModelType& Model, const TSharedPtr<FJsonValue>& JsonValue);
+	bool (*ReadStream)(ModelType& Model, StreamReaderType& Reader);
+	void (*Write)(const ModelType& Model, WriterType& Writer, const TCHAR* Name);
+	void (*Reset)(ModelType& Model);
+};
+
+template<typename Codec, typename ModelType, typename MemberType, MemberType ModelType::*Member>
+struct TFieldAccess
+{
+	static constexpr bool bRequired = true;
+
+	static bool ReadValue(ModelType& Model, const TSharedPtr<FJsonValue>& JsonValue)
+	{
+		return Codec::Read(JsonValue, Model.*Member);
+	}
+
+	static bool ReadStream(ModelType& Model, typename Codec::StreamReader& Reader)
+	{
+		return Codec::Read(Reader, Model.*Member);
+	}
+
+	static void Write(const ModelType& Model, typename Codec::Writer& Writer, const TCHAR* Name)
+	{
+		Writer->WriteIdentifierPrefix(Name);
+		Codec::Write(Writer, Model.*Member);
+	}
+
+	/* A required field missing from the JSON fails the decoding, it is left as is */
+	static void Reset(ModelType& Model)
+	{
+	}
+};
+
+template<typename Codec, typename ModelType, typename T, TOptional<T> ModelType::*Member>
+struct TFieldAccess<Codec, ModelType, TOptional<T>, Member>
+{
+	static constexpr bool bRequired = false;
+
+	static bool ReadValue(ModelType& Model, const TSharedPtr<FJsonValue>& JsonValue)
+	{
+		T Value;
+		if (Codec::Read(JsonValue, Value))
+		{
+			(Model.*Member) = MoveTemp(Value);
+			return true;
+		}
+		return false;
+	}
+
+	static bool ReadStream(ModelType& Model, typename Codec::StreamReader& Reader)
+	{
+		return Codec::Read(Reader, Model.*Member);
+	}
+
+	static void Write(const ModelType& Model, typename Codec::Writer& Writer, const TCHAR* Name)
+	{
+		if ((Model.*Member).IsSet())
+		{
+			Writer->WriteIdentifierPrefix(Name);
+			Codec::Write(Writer, (Model.*Member).GetValue());
+		}
+	}
+
+	static void Reset(ModelType& Model)
+	{
+		(Model.*Member).Reset();
+	}
+};
+
+/* Entry of a field table, for the member Member of ModelType serialized under the ASCII key Key */
+#define OPENAPI_MODEL_FIELD(Codec, ModelType, Key, Member) \
+	{ \
+		Key, TEXT(Key), ::IMSOpenAPI::HashFieldName(Key), \
+		::IMSOpenAPI::TFieldAccess<Codec, ModelType, decltype(ModelType::Member), &ModelType::Member>::bRequired, \
+		&::IMSOpenAPI::TFieldAccess<Codec, ModelType, decltype(ModelType::Member), &ModelType::Member>::ReadValue, \
+		&::IMSOpenAPI::TFieldAccess<Codec, ModelType, decltype(ModelType::Member), &ModelType::Member>::ReadStream, \
+		&::IMSOpenAPI::TFieldAccess<Codec, ModelType, decltype(ModelType::Member), &ModelType::Member>::Write, \
+		&::IMSOpenAPI::TFieldAccess<Codec, ModelType, decltype(ModelType::Member), &ModelType::Member>::Reset \
+	}
+
+/*
+ * Returns the index of the field with the given key hash, or INDEX_NONE. The search starts after the previous match
+ * since fields usually come in the order of the table.
+ */
+template<typename FieldType, int32 NumFields, typename KeyEqualsType>
+int32 FindField(const FieldType (&Fields)[NumFields], uint32 Hash, int32& InOutHint, KeyEqualsType&& KeyEquals)
+{
+	for (int32 Count = 0, Index = InOutHint; Count < NumFields; ++Count, Index = Index + 1 < NumFields ? Index + 1 : 0)
+	{
+		if (Fields[Index].Hash == Hash && KeyEquals(Fields[Index]))
+		{
+			InOutHint = Index + 1 < NumFields ? Index + 1 : 0;
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+template<typename FieldType, int32 NumFields>
+bool HasRequiredFields(const FieldType (&Fields)[NumFields], uint64 FoundFields)
+{
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		if (Fields[Index].bRequired && (FoundFields & (1ull << Index)) == 0)
+			return false; // Missing required fields are parsing errors
+	}
+	return true;
+}
+
+/*
+ * Models are decoded in place, so that a model decoded again keeps the allocations of its fields (see TResponsePool).
+ * The optional fields missing from the JSON are reset rather than keeping their previous value.
+ */
+template<typename ModelType, typename FieldType, int32 NumFields>
+void ResetMissingFields(ModelType& Model, const FieldType (&Fields)[NumFields], uint64 FoundFields)
+{
+	for (int32 Index = 0; Index < NumFields; ++Index)
+	{
+		if (!Fields[Index].bRequired && (FoundFields & (1ull << Index)) == 0)
+		{
+			Fields[Index].Reset(Model);
+		}
+	}
+}
+
+template<typename ModelType, typename Codec, int32 NumFields>
+bool ReadModel(ModelType& Model, const TModelField<ModelType, Codec> (&Fields)[NumFields], const TSharedPtr<FJsonValue>& JsonValue)
+{
+	static_assert(NumFields <= 64, "Field tables are limited to 64 fields");
+
+	const TSharedPtr<FJsonObject>* Object;
+	if (!JsonValue->TryGetObject(Object))
+		return false;
+
+	bool ParseSuccess = true;
+	uint64 FoundFields = 0;
+	int32 Hint = 0;
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Object)->Values)
+	{
+		const int32 Index = FindField(Fields, HashFieldName(Pair.Key), Hint, [&Pair](const TModelField<ModelType, Codec>& Field)
+		{
+			return FCString::Strcmp(*Pair.Key, Field.WideName) == 0;
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			// Null values are parsing errors, even for optional fields
+			FoundFields |= 1ull << Index;
+			ParseSuccess &= Pair.Value.IsValid() && !Pair.Value->IsNull() && Fields[Index].ReadValue(Model, Pair.Value);
+		}
+	}
+
+	ResetMissingFields(Model, Fields, FoundFields);
+	return ParseSuccess && HasRequiredFields(Fields, FoundFields);
+}
+
+template<typename ModelType, typename Codec, int32 NumFields>
+bool ReadModel(ModelType& Model, const TModelField<ModelType, Codec> (&Fields)[NumFields], typename Codec::StreamReader& Reader)
+{
+	static_assert(NumFields <= 64, "Field tables are limited to 64 fields");
+
+	if (!Reader.ReadObjectStart())
+		return false;
+
+	bool ParseSuccess = true;
+	uint64 FoundFields = 0;
+	int32 Hint = 0;
+
+	while (Reader.NextField())
+	{
+		const int32 Index = FindField(Fields, Reader.GetKeyHash(), Hint, [&Reader](const TModelField<ModelType, Codec>& Field)
+		{
+			return Reader.IsKey(Field.Name);
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			FoundFields |= 1ull << Index;
+			ParseSuccess &= Fields[Index].ReadStream(Model, Reader);
+		}
+		else
+		{
+			Reader.SkipValue();
+		}
+	}
+
+	ResetMissingFields(Model, Fields, FoundFields);
+	return ParseSuccess && !Reader.HasError() && HasRequiredFields(Fields, FoundFields);
+}
+
+template<typename ModelType, typename Codec, int32 NumFields>
+void WriteModel(const ModelType& Model, const TModelField<ModelType, Codec> (&Fields)[NumFields], typename Codec::Writer& Writer)
+{
+	Writer->WriteObjectStart();
+	for (const TModelField<ModelType, Codec>& Field : Fields)
+	{
+		Field.Write(Model, Writer, Field.WideName);
+	}
+	Writer->WriteObjectEnd();
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+class IFileHandle;
+
+namespace IMSOpenAPI
+{
+
+/*
+ * Request body made of in-memory segments and files, read by the HTTP module while the request is sent (see
+ * IHttpRequest::SetContentFromStream). Files are read from disk a chunk at a time, so the memory needed to send a
+ * body does not depend on the size of its files, and the content length is known from their sizes up front.
+ *
+ * Consecutive bytes are appended to the same in-memory segment.
+ */
+class IMSOPENAPIRUNTIME_API FHttpBodyStream final : public FArchive
+{
+public:
+	FHttpBodyStream();
+	virtual ~FHttpBodyStream();
+
+	void AppendBytes(const uint8* Data, int64 Num);
+	void AppendUtf8(const FString& String);
+
+	/* Appends a file, returns false if it cannot be found. The file is expected to be left untouched until sent */
+	bool AppendFile(const FString& FilePath);
+
+	bool HasFiles() const { return NumFiles > 0; }
+
+	/* Moves the body out as a single buffer, only for bodies without files */
+	TArray<uint8> ReleaseBytes();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Seek(int64 InPosition) override;
+	virtual int64 Tell() override { return Position; }
+	virtual int64 TotalSize() override { return Size; }
+	virtual FString GetArchiveName() const override { return TEXT("FHttpBodyStream"); }
+	//~ End FArchive Interface
+
+private:
+	struct FSegment
+	{
+		int64 Offset = 0;
+		int64 Size = 0;
+		TArray<uint8> Bytes;
+		FString FilePath;
+	};
+
+	/* Reads from the file of the segment, opening it the first time */
+	bool ReadFile(int32 SegmentIndex, int64 SegmentPosition, uint8* Data, int64 Num);
+
+	TArray<FSegment> Segments;
+	int64 Size;
+	int32 NumFiles;
+
+	/* Read position, and the segment it is in */
+	int64 Position;
+	int32 SegmentIndex;
+
+	/* File being read and the index of its segment */
+	TUniquePtr<IFileHandle> FileHandle;
+	int32 FileSegmentIndex;
+};
+
+}
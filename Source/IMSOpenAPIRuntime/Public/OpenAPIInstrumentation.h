@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+IMSOPENAPIRUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogIMSOpenAPI, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("IMS"), STATGROUP_IMS, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decode response"), STAT_IMS_DecodeResponse, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Responses"), STAT_IMS_Responses, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Failed responses"), STAT_IMS_FailedResponses, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Retries"), STAT_IMS_Retries, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes sent"), STAT_IMS_BytesSent, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes received"), STAT_IMS_BytesReceived, STATGROUP_IMS, IMSOPENAPIRUNTIME_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(IMSOPENAPIRUNTIME_API, IMS);
+
+namespace IMSOpenAPI
+{
+
+/*
+ * Histogram of durations with a bounded relative error, in the manner of HdrHistogram: each power of two of
+ * microseconds is split in 16 buckets, so that percentiles are within 1/16 of the recorded durations from 1us up to
+ * about 71 minutes, in a fixed amount of memory and without sorting samples.
+ */
+class IMSOPENAPIRUNTIME_API FLatencyHistogram
+{
+public:
+	FLatencyHistogram();
+
+	void Record(double Seconds);
+	void Reset();
+
+	uint64 GetCount() const { return TotalCount; }
+	double GetMaxSeconds() const { return MaxMicros * 1e-6; }
+	double GetMeanSeconds() const { return TotalCount > 0 ? TotalMicros * 1e-6 / TotalCount : 0.0; }
+
+	/* Duration under which the given percentage of the recorded durations are, Percentile being in [0, 100] */
+	double GetPercentileSeconds(double Percentile) const;
+
+private:
+	static int32 GetBucketIndex(uint64 Micros);
+
+	/* Highest duration counted in the bucket */
+	static uint64 GetBucketValue(int32 Index);
+
+	enum
+	{
+		SubBucketBits = 4,
+		SubBucketCount = 1 << SubBucketBits,
+		MaxValueBits = 32,
+		NumBuckets = SubBucketCount * (MaxValueBits - SubBucketBits + 1),
+	};
+
+	uint32 Counts[NumBuckets];
+	uint64 TotalCount;
+	uint64 TotalMicros;
+	uint64 MaxMicros;
+};
+
+/* Counters of an operation since the start or the last reset */
+struct FOperationStats
+{
+	FLatencyHistogram Latency;
+	FLatencyHistogram DecodeTime;
+	uint64 Responses = 0;
+	uint64 Failures = 0;
+	uint64 Retries = 0;
+	uint64 BytesSent = 0;
+	uint64 BytesReceived = 0;
+	int32 MaxResponseBytes = 0;
+};
+
+/*
+ * Per operation latency, size and decode time counters of the generated APIs.
+ *
+ * The generated APIs record each response once decoded, callers that retry requests themselves record their retries.
+ * The counters are dumped by the ims.Api.Stats console command, also feed STATGROUP_IMS, and the IMS CSV profiler
+ * category with one latency stat per operation.
+ */
+class IMSOPENAPIRUNTIME_API FInstrumentation
+{
+public:
+	static FInstrumentation& Get();
+
+	/* Records a response of the operation, bSuccessful being whether a 2xx response was received */
+	void RecordResponse(const TCHAR* Operation, const FHttpRequestPtr& HttpRequest, const FHttpResponsePtr& HttpResponse, bool bSuccessful, double DecodeSeconds);
+	void RecordRetry(const TCHAR* Operation);
+
+	/* Copy of the counters of each operation */
+	TMap<FName, FOperationStats> GetStats() const;
+
+	void DumpStats() const;
+	void ResetStats();
+
+private:
+	struct FOperation
+	{
+		FOperationStats Stats;
+		FName CsvLatencyStat;
+		FName CsvDecodeTimeStat;
+	};
+
+	FOperation& FindOrAddOperation(const TCHAR* Operation);
+
+	mutable FCriticalSection CriticalSection;
+	TMap<FName, FOperation> Operations;
+};
+
+}
@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace IMSOpenAPI
+{
+
+/*
+ * JsonStreamReader
+ *
+ * Pull reader over UTF-8 encoded JSON, used to decode responses straight into the models without building a
+ * FJsonValue DOM or converting the whole body to a wide string first. Only strings are converted, one at a time.
+ *
+ * Value readers skip the value and return false when it has another type, so that the caller can carry on with the
+ * next field like the DOM path does. Malformed JSON stops the reader, see HasError.
+ */
+class IMSOPENAPIRUNTIME_API JsonStreamReader
+{
+public:
+	JsonStreamReader(const uint8* InData, int32 InSize);
+
+	/* Enters an object, then NextField moves to each of its fields and returns false once the object has been left */
+	bool ReadObjectStart();
+	bool NextField();
+
+	/* Returns whether the key of the current field is the given ASCII key */
+	bool IsKey(const ANSICHAR* InKey) const;
+
+	/* Key of the current field */
+	FString GetKey() const;
+
+	/* Hash of the key of the current field, see HashFieldName */
+	uint32 GetKeyHash() const;
+
+	/* Enters an array, then NextElement moves to each of its elements and returns false once the array has been left */
+	bool ReadArrayStart();
+	bool NextElement();
+
+	bool ReadString(FString& OutValue);
+	bool ReadNumber(double& OutValue);
+	bool ReadInt32(int32& OutValue);
+	bool ReadInt64(int64& OutValue);
+	bool ReadBool(bool& OutValue);
+
+	/* Decodes a Base64Url string straight from the input, see Base64UrlDecode */
+	bool ReadBase64Url(TArray<uint8>& OutValue);
+
+	/* Consumes a null value, returns false and leaves the value unread if it is not null */
+	bool TryReadNull();
+
+	/* Skips the next value, including nested objects and arrays */
+	bool SkipValue();
+
+	/* Returns true once the JSON has been found to be malformed */
+	bool HasError() const { return bError; }
+
+private:
+	void SkipWhitespace();
+	bool Fail();
+	ANSICHAR Peek();
+
+	/* Consumes the literal if it is next in the input */
+	bool MatchLiteral(const ANSICHAR* Literal, int32 Length);
+
+	/* Reads a string token, OutString points either into the input or into Scratch when it had escape sequences */
+	bool ReadRawString(const ANSICHAR*& OutString, int32& OutLength, TArray<ANSICHAR>& Scratch);
+	bool ReadRawNumber(ANSICHAR* OutBuffer, int32 BufferSize);
+
+	/* Moves to the next item of the innermost container, returns false at its end */
+	bool NextItem(ANSICHAR EndChar);
+
+	const ANSICHAR* Data;
+	int32 Size;
+	int32 Position;
+	bool bError;
+
+	/* Whether an item was already read in each of the containers being read */
+	TArray<bool, TInlineAllocator<16>> ContainerHasItems;
+
+	const ANSICHAR* Key;
+	int32 KeyLength;
+	TArray<ANSICHAR> KeyScratch;
+	TArray<ANSICHAR> StringScratch;
+};
+
+}
@@ -0,0 +1,269 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Misc/StringBuilder.h"
+#include "Dom/JsonObject.h"
+#include "HttpRetrySystem.h"
+#include "Containers/Ticker.h"
+#include "OpenAPICancellation.h"
+
+/*
+ * Base classes of the generated OpenAPI modules
+ *
+ * The generated modules alias them into their own namespace (see their OpenAPIBaseModel.h), so that every API shares
+ * the same code, and the same retry manager unless one is set.
+ */
+namespace IMSOpenAPI
+{
+
+typedef TSharedRef<TJsonWriter<UTF8CHAR, TCondensedJsonPrintPolicy<UTF8CHAR>>> JsonWriter;
+class JsonStreamReader;
+
+struct IMSOPENAPIRUNTIME_API HttpRetryManager : public FHttpRetrySystem::FManager, public FTickerObjectBase
+{
+	using FManager::FManager;
+
+	bool Tick(float DeltaTime) final;
+
+	/* Retry manager of the APIs without one set, alive as long as one of them holds it */
+	static TSharedRef<HttpRetryManager> GetShared();
+};
+
+struct IMSOPENAPIRUNTIME_API HttpRetryParams
+{
+	HttpRetryParams(
+		const FHttpRetrySystem::FRetryLimitCountSetting& InRetryLimitCountOverride = FHttpRetrySystem::FRetryLimitCountSetting(),
+		const FHttpRetrySystem::FRetryTimeoutRelativeSecondsSetting& InRetryTimeoutRelativeSecondsOverride = FHttpRetrySystem::FRetryTimeoutRelativeSecondsSetting(),
+		const FHttpRetrySystem::FRetryResponseCodes& InRetryResponseCodes = FHttpRetrySystem::FRetryResponseCodes(),
+		const FHttpRetrySystem::FRetryVerbs& InRetryVerbs = FHttpRetrySystem::FRetryVerbs(),
+		const FHttpRetrySystem::FRetryDomainsPtr& InRetryDomains = FHttpRetrySystem::FRetryDomainsPtr()
+	);
+
+	FHttpRetrySystem::FRetryLimitCountSetting              RetryLimitCountOverride;
+	FHttpRetrySystem::FRetryTimeoutRelativeSecondsSetting  RetryTimeoutRelativeSecondsOverride;
+	FHttpRetrySystem::FRetryResponseCodes                  RetryResponseCodes;
+	FHttpRetrySystem::FRetryVerbs                          RetryVerbs;
+	FHttpRetrySystem::FRetryDomainsPtr                     RetryDomains;
+};
+
+class IMSOPENAPIRUNTIME_API Model
+{
+public:
+	virtual ~Model() {}
+	virtual void WriteJson(JsonWriter& Writer) const = 0;
+	virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) = 0;
+
+	/* Decodes the model from a JSON stream, models without support skip the value and return false */
+	virtual bool FromJsonStream(JsonStreamReader& Reader);
+};
+
+class IMSOPENAPIRUNTIME_API Request
+{
+public:
+	virtual ~Request() {}
+	virtual void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const = 0;
+	virtual void AppendPath(FStringBuilderBase& Builder) const = 0;
+
+	/* Name of the operation, under which its responses are recorded by FInstrumentation */
+	virtual const TCHAR* GetOperationName() const = 0;
+
+	FString ComputePath() const;
+
+	/* The URL is kept with the request, a request reused for the same path does not build it again */
+	const FString& ComputeUrl(const FString& BaseUrl) const;
+
+	/* Enables retry and optionally sets a retry policy for this request */
+	void SetShouldRetry(const HttpRetryParams& Params = HttpRetryParams()) { RetryParams = Params; }
+	const TOptional<HttpRetryParams>& GetRetryParams() const { return RetryParams; }
+
+	/* Cancels the request with the token, see FCancellationToken. Only a weak reference to the token is kept, the request
+	* is cancelled once it is destroyed */
+	void SetCancellationToken(const FCancellationTokenRef& Token) { CancellationToken = FCancellationTokenWeakPtr(Token); }
+
+	/* Absolute deadline in FPlatformTime::Seconds, the request times out once it is reached, retries included */
+	void SetDeadline(double InDeadline) { Deadline = InDeadline; }
+	const TOptional<double>& GetDeadline() const { return Deadline; }
+
+	/* Whether the token of the request was cancelled or destroyed */
+	bool IsCancelled() const;
+	bool HasDeadlinePassed() const;
+
+	/* Requests that may be cancelled are not shared with identical requests, see SingleFlightRequests */
+	bool IsCancellable() const { return CancellationToken.IsSet() || Deadline.IsSet(); }
+
+	/* Registers the HTTP request issued for this request with its token, returns false if it was cancelled */
+	bool RegisterHttpRequest(const FHttpRequestRef& HttpRequest) const;
+
+private:
+	mutable FString CachedUrl;
+	TOptional<HttpRetryParams> RetryParams;
+	TOptional<FCancellationTokenWeakPtr> CancellationToken;
+	TOptional<double> Deadline;
+};
+
+/*
+ * Writes a request body as UTF-8 JSON into a buffer reserved from the size of the previous body written with the same
+ * size hint, then moves it into the HTTP request, so that a body is neither converted nor grown while written.
+ */
+class IMSOPENAPIRUNTIME_API JsonBodyWriter
+{
+public:
+	explicit JsonBodyWriter(int32& InOutSizeHint);
+
+	JsonWriter& GetWriter() { return Writer; }
+
+	/* Closes the writer and moves the body into the request */
+	void SetupHttpRequest(const FHttpRequestRef& HttpRequest);
+
+	/* Closes the writer and returns the body as a string */
+	FString ToString();
+
+private:
+	int32& SizeHint;
+	TArray<uint8> Buffer;
+	FMemoryWriter Archive;
+	JsonWriter Writer;
+};
+
+class IMSOPENAPIRUNTIME_API Response
+{
+public:
+	virtual ~Response() {}
+	virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) = 0;
+
+	/* Responses that can be decoded from the UTF-8 body directly, see JsonStreamReader */
+	virtual bool SupportsJsonStream() const { return false; }
+	virtual bool FromJsonStream(JsonStreamReader& Reader) { return false; }
+
+	void SetSuccessful(bool InSuccessful) { Successful = InSuccessful; }
+	bool IsSuccessful() const { return Successful; }
+
+	virtual void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode);
+	EHttpResponseCodes::Type GetHttpResponseCode() const { return ResponseCode; }
+
+	void SetResponseString(const FString& InResponseString) { ResponseString = InResponseString; }
+	const FString& GetResponseString() const { return ResponseString; }
+
+	void SetHttpResponse(const FHttpResponsePtr& InHttpResponse) { HttpResponse = InHttpResponse; }
+	const FHttpResponsePtr& GetHttpResponse() const { return HttpResponse; }
+
+	/* Clears the status of a response about to be reused, see TResponsePool. Its content is decoded again in place */
+	void ResetStatus();
+
+private:
+	bool Successful;
+	EHttpResponseCodes::Type ResponseCode;
+	FString ResponseString;
+	FHttpResponsePtr HttpResponse;
+};
+
+/*
+ * Response of an operation kept between its calls, so that steady traffic decodes into the same strings, arrays and
+ * maps instead of allocating them for each reply. Delegates get the pooled response for the duration of the call, so
+ * they copy what they keep, and the content of an unsuccessful response may still hold the previous values.
+ *
+ * The response is taken through TPooledResponse, which falls back to a response of its own while the pooled one is
+ * taken, for a delegate completing another call of the same operation.
+ */
+template<typename ResponseType>
+class TResponsePool
+{
+public:
+	/* Returns the pooled response, or nullptr if it is already taken */
+	ResponseType* Acquire()
+	{
+		if (bAcquired)
+			return nullptr;
+
+		if (!PooledResponse.IsValid())
+		{
+			PooledResponse = MakeUnique<ResponseType>();
+		}
+		else
+		{
+			PooledResponse->ResetStatus();
+		}
+
+		bAcquired = true;
+		return PooledResponse.Get();
+	}
+
+	void Release() { bAcquired = false; }
+
+private:
+	TUniquePtr<ResponseType> PooledResponse;
+	bool bAcquired = false;
+};
+
+template<typename ResponseType>
+class TPooledResponse : public FNoncopyable
+{
+public:
+	/* Takes the response from the pool, or uses its own if there is no pool */
+	explicit TPooledResponse(TResponsePool<ResponseType>* InPool)
+		: Pool(InPool)
+		, Response(InPool ? InPool->Acquire() : nullptr)
+	{
+		if (!Response)
+		{
+			Pool = nullptr;
+			Response = &OwnResponse.Emplace();
+		}
+	}
+
+	~TPooledResponse()
+	{
+		if (Pool)
+		{
+			Pool->Release();
+		}
+	}
+
+	ResponseType& Get() { return *Response; }
+
+private:
+	TResponsePool<ResponseType>* Pool;
+	ResponseType* Response;
+	TOptional<ResponseType> OwnResponse;
+};
+
+/*
+ * GET requests in flight, by verb, URL and headers. Identical requests join the one in flight instead of being issued,
+ * and its response is handed to each of them, so that callers polling a slow endpoint do not pile requests up.
+ */
+class IMSOPENAPIRUNTIME_API SingleFlightRequests
+{
+public:
+	typedef TFunction<void(const Response&)> FOnComplete;
+
+	static FString MakeKey(const TCHAR* Verb, const FString& Url, const TMap<FString, FString>& Headers);
+
+	/* Returns the request in flight with the key after adding OnComplete to it, or nullptr if there is none */
+	FHttpRequestPtr Join(const FString& Key, FOnComplete&& OnComplete);
+
+	/* Adds a request about to be issued, before ProcessRequest since it may complete right away */
+	void Add(const FString& Key, const FHttpRequestRef& HttpRequest);
+
+	/* Removes the request once it completed and returns the callbacks of the requests that joined it */
+	TArray<FOnComplete> Complete(const FString& Key);
+
+	/* Forgets the requests in flight along with the requests that joined them, once they have been cancelled */
+	void Reset() { Flights.Reset(); }
+
+private:
+	struct Flight
+	{
+		FHttpRequestPtr HttpRequest;
+		TArray<FOnComplete> Joined;
+	};
+
+	TMap<FString, Flight> Flights;
+};
+
+}
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "OpenAPIHttpBodyStream.h"
+
+namespace IMSOpenAPI
+{
+
+class IMSOPENAPIRUNTIME_API HttpFileInput
+{
+public:
+	explicit HttpFileInput(const TCHAR* InFilePath);
+	explicit HttpFileInput(const FString& InFilePath);
+
+	// This will automatically set the content type if not already set
+    void SetFilePath(const TCHAR* InFilePath);
+	void SetFilePath(const FString& InFilePath);
+
+    // Optional if it can be deduced from the FilePath
+    void SetContentType(const TCHAR* ContentType);
+
+	HttpFileInput& operator=(const HttpFileInput& Other) = default;
+	HttpFileInput& operator=(const FString& InFilePath) { SetFilePath(*InFilePath); return*this; }
+	HttpFileInput& operator=(const TCHAR* InFilePath) { SetFilePath(InFilePath); return*this; }
+
+	const FString& GetFilePath() const { return FilePath; }
+	const FString& GetContentType() const { return ContentType; }
+
+	// Returns the filename with extension
+	FString GetFilename() const;
+
+private:
+    FString FilePath;
+    FString ContentType;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+/*
+ * Multipart form data body. File parts are not loaded: they are read from disk while the request is sent, see
+ * FHttpBodyStream, so that uploading a file does not take memory in proportion to its size.
+ */
+class IMSOPENAPIRUNTIME_API HttpMultipartFormData
+{
+public:
+	HttpMultipartFormData();
+
+	void SetBoundary(const TCHAR* InBoundary);
+	void SetupHttpRequest(const FHttpRequestRef& HttpRequest);
+
+	void AddStringPart(const TCHAR* Name, const TCHAR* Data);
+	void AddJsonPart(const TCHAR* Name, const FString& JsonString);
+	void AddBinaryPart(const TCHAR* Name, const TArray<uint8>& ByteArray);
+	void AddFilePart(const TCHAR* Name, const HttpFileInput& File);
+
+private:
+	/* Appends the boundary line and the headers of a part, encoded at once */
+	void AppendPartHeader(const TCHAR* Name, const TCHAR* Filename, const TCHAR* ContentType);
+	void AppendBoundary();
+	void AppendString(const TCHAR* Str);
+	const FString& GetBoundary() const;
+
+	mutable FString Boundary;
+
+	/* Delimiter and boundary, encoded once */
+	TArray<uint8> EncodedBoundary;
+
+	TSharedRef<FHttpBodyStream, ESPMode::ThreadSafe> FormData;
+
+	static const TCHAR* Delimiter;
+	static const TCHAR* Newline;
+};
+
+}
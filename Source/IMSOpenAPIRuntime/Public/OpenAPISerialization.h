@@ -0,0 +1,599 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "OpenAPIModel.h"
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIBase64.h"
+#include "OpenAPIFieldTable.h"
+
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Base64.h"
+
+/*
+ * String, URL and JSON conversions of the values of the generated models and requests
+ *
+ * Generic overloads only call the others unqualified, so that the overloads a generated module declares for its own
+ * types (such as its enums) are found through argument dependent lookup.
+ */
+namespace IMSOpenAPI
+{
+
+//////////////////////////////////////////////////////////////////////////
+
+// Decodes Base64Url encoded strings, see https://en.wikipedia.org/wiki/Base64#Variants_summary_table
+inline bool Base64UrlDecode(const FString& Base64String, TArray<uint8>& Value)
+{
+	return Base64UrlDecode(*Base64String, Base64String.Len(), Value);
+}
+
+template<typename T>
+bool Base64UrlDecode(const FString& Base64String, T& Value)
+{
+	FString TmpCopy(Base64String);
+	TmpCopy.ReplaceInline(TEXT("-"), TEXT("+"));
+	TmpCopy.ReplaceInline(TEXT("_"), TEXT("/"));
+
+	return FBase64::Decode(TmpCopy, Value);
+}
+
+// Encodes strings in Base64Url, see https://en.wikipedia.org/wiki/Base64#Variants_summary_table
+inline FString Base64UrlEncode(const TArray<uint8>& Value)
+{
+	return Base64UrlEncode(Value.GetData(), Value.Num());
+}
+
+template<typename T>
+FString Base64UrlEncode(const T& Value)
+{
+	FString Base64String = FBase64::Encode(Value);
+	Base64String.ReplaceInline(TEXT("+"), TEXT("-"));
+	Base64String.ReplaceInline(TEXT("/"), TEXT("_"));
+	return Base64String;
+}
+
+template<typename T>
+inline FStringFormatArg ToStringFormatArg(const T& Value)
+{
+	return FStringFormatArg(Value);
+}
+
+inline FStringFormatArg ToStringFormatArg(const FDateTime& Value)
+{
+	return FStringFormatArg(Value.ToIso8601());
+}
+
+inline FStringFormatArg ToStringFormatArg(const FGuid& Value)
+{
+	return FStringFormatArg(Value.ToString(EGuidFormats::DigitsWithHyphens));
+}
+
+inline FStringFormatArg ToStringFormatArg(const TArray<uint8>& Value)
+{
+	return FStringFormatArg(Base64UrlEncode(Value));
+}
+
+template<typename T, typename std::enable_if<!std::is_base_of<Model, T>::value, int>::type = 0>
+inline FString ToString(const T& Value)
+{
+	return FString::Format(TEXT("{0}"), { ToStringFormatArg(Value) });
+}
+
+inline FString ToString(const FString& Value)
+{
+	return Value;
+}
+
+inline FString ToString(bool Value)
+{
+	return Value ? TEXT("true") : TEXT("false");
+}
+
+inline FStringFormatArg ToStringFormatArg(bool Value)
+{
+	return FStringFormatArg(ToString(Value));
+}
+
+inline FString ToString(const TArray<uint8>& Value)
+{
+	return Base64UrlEncode(Value);
+}
+
+inline FString ToString(const Model& Value)
+{
+	int32 SizeHint = 0;
+	JsonBodyWriter Writer(SizeHint);
+	Value.WriteJson(Writer.GetWriter());
+	return Writer.ToString();
+}
+
+inline void AppendString(FStringBuilderBase& Builder, const FString& Value)
+{
+	Builder.Append(*Value, Value.Len());
+}
+
+template<typename T>
+inline void AppendString(FStringBuilderBase& Builder, const T& Value)
+{
+	AppendString(Builder, ToString(Value));
+}
+
+// Percent-encodes everything but the unreserved characters of RFC 3986
+inline void AppendUrlString(FStringBuilderBase& Builder, const FString& Value)
+{
+	static const TCHAR HexDigits[] = TEXT("0123456789ABCDEF");
+
+	const FTCHARToUTF8 Utf8Value(*Value);
+	const uint8* Bytes = reinterpret_cast<const uint8*>(Utf8Value.Get());
+	for (int32 Index = 0; Index < Utf8Value.Length(); ++Index)
+	{
+		const uint8 Byte = Bytes[Index];
+		if ((Byte >= 'A' && Byte <= 'Z') || (Byte >= 'a' && Byte <= 'z') || (Byte >= '0' && Byte <= '9') || Byte == '-' || Byte == '_' || Byte == '.' || Byte == '~')
+		{
+			Builder.AppendChar(static_cast<TCHAR>(Byte));
+		}
+		else
+		{
+			Builder.AppendChar(TEXT('%'));
+			Builder.AppendChar(HexDigits[Byte >> 4]);
+			Builder.AppendChar(HexDigits[Byte & 0xF]);
+		}
+	}
+}
+
+template<typename T>
+inline void AppendUrlString(FStringBuilderBase& Builder, const T& Value)
+{
+	AppendUrlString(Builder, ToString(Value));
+}
+
+template<typename T>
+inline FString ToUrlString(const T& Value)
+{
+	TStringBuilder<128> Builder;
+	AppendUrlString(Builder, Value);
+	return FString(Builder.Len(), Builder.GetData());
+}
+
+template<typename T>
+inline FString CollectionToUrlString(const TArray<T>& Collection, const TCHAR* Separator)
+{
+	TStringBuilder<256> Builder;
+	for(int i = 0; i < Collection.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Builder << Separator;
+		}
+		AppendUrlString(Builder, Collection[i]);
+	}
+	return FString(Builder.Len(), Builder.GetData());
+}
+
+template<typename T>
+inline FString CollectionToUrlString_csv(const TArray<T>& Collection, const TCHAR* BaseName)
+{
+	return CollectionToUrlString(Collection, TEXT(","));
+}
+
+template<typename T>
+inline FString CollectionToUrlString_ssv(const TArray<T>& Collection, const TCHAR* BaseName)
+{
+	return CollectionToUrlString(Collection, TEXT(" "));
+}
+
+template<typename T>
+inline FString CollectionToUrlString_tsv(const TArray<T>& Collection, const TCHAR* BaseName)
+{
+	return CollectionToUrlString(Collection, TEXT("\t"));
+}
+
+template<typename T>
+inline FString CollectionToUrlString_pipes(const TArray<T>& Collection, const TCHAR* BaseName)
+{
+	return CollectionToUrlString(Collection, TEXT("|"));
+}
+
+template<typename T>
+inline FString CollectionToUrlString_multi(const TArray<T>& Collection, const TCHAR* BaseName)
+{
+	TStringBuilder<256> Builder;
+	for(int i = 0; i < Collection.Num(); i++)
+	{
+		if (i > 0)
+		{
+			Builder.AppendChar(TEXT('&'));
+		}
+		Builder << BaseName;
+		Builder.AppendChar(TEXT('='));
+		AppendUrlString(Builder, Collection[i]);
+	}
+	return FString(Builder.Len(), Builder.GetData());
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+inline void WriteJsonValue(JsonWriter& Writer, const TSharedPtr<FJsonValue>& Value)
+{
+	if (Value.IsValid())
+	{
+		FJsonSerializer::Serialize(Value.ToSharedRef(), "", Writer, false);
+	}
+	else
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteObjectEnd();
+	}
+}
+
+inline void WriteJsonValue(JsonWriter& Writer, const TSharedPtr<FJsonObject>& Value)
+{
+	if (Value.IsValid())
+	{
+		FJsonSerializer::Serialize(Value.ToSharedRef(), Writer, false);
+	}
+	else
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteObjectEnd();
+	}
+}
+
+inline void WriteJsonValue(JsonWriter& Writer, const TArray<uint8>& Value)
+{
+	Writer->WriteValue(ToString(Value));
+}
+
+inline void WriteJsonValue(JsonWriter& Writer, const FDateTime& Value)
+{
+	Writer->WriteValue(Value.ToIso8601());
+}
+
+inline void WriteJsonValue(JsonWriter& Writer, const FGuid& Value)
+{
+	Writer->WriteValue(Value.ToString(EGuidFormats::DigitsWithHyphens));
+}
+
+inline void WriteJsonValue(JsonWriter& Writer, const Model& Value)
+{
+	Value.WriteJson(Writer);
+}
+
+template<typename T, typename std::enable_if<!std::is_base_of<Model, T>::value, int>::type = 0>
+inline void WriteJsonValue(JsonWriter& Writer, const T& Value)
+{
+	Writer->WriteValue(Value);
+}
+
+template<typename T>
+inline void WriteJsonValue(JsonWriter& Writer, const TArray<T>& Value)
+{
+	Writer->WriteArrayStart();
+	for (const auto& Element : Value)
+	{
+		WriteJsonValue(Writer, Element);
+	}
+	Writer->WriteArrayEnd();
+}
+
+template<typename T>
+inline void WriteJsonValue(JsonWriter& Writer, const TMap<FString, T>& Value)
+{
+	Writer->WriteObjectStart();
+	for (const auto& It : Value)
+	{
+		Writer->WriteIdentifierPrefix(It.Key);
+		WriteJsonValue(Writer, It.Value);
+	}
+	Writer->WriteObjectEnd();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, FString& Value)
+{
+	FString TmpValue;
+	if (JsonValue->TryGetString(TmpValue))
+	{
+		Value = TmpValue;
+		return true;
+	}
+	else
+		return false;
+}
+
+IMSOPENAPIRUNTIME_API bool ParseDateTime(const FString& DateTimeString, FDateTime& OutDateTime);
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, FDateTime& Value)
+{
+	FString TmpValue;
+	if (JsonValue->TryGetString(TmpValue))
+	{
+		return ParseDateTime(TmpValue, Value);
+	}
+	else
+		return false;
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, FGuid& Value)
+{
+	FString TmpValue;
+	if (JsonValue->TryGetString(TmpValue))
+	{
+		return FGuid::Parse(TmpValue, Value);
+	}
+	else
+		return false;
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, bool& Value)
+{
+	bool TmpValue;
+	if (JsonValue->TryGetBool(TmpValue))
+	{
+		Value = TmpValue;
+		return true;
+	}
+	else
+		return false;
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TSharedPtr<FJsonValue>& JsonObjectValue)
+{
+	JsonObjectValue = JsonValue;
+	return true;
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TSharedPtr<FJsonObject>& JsonObjectValue)
+{
+	const TSharedPtr<FJsonObject>* Object;
+	if (JsonValue->TryGetObject(Object))
+	{
+		JsonObjectValue = *Object;
+		return true;
+	}
+	return false;
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TArray<uint8>& Value)
+{
+	FString TmpValue;
+	return JsonValue->TryGetString(TmpValue) && Base64UrlDecode(TmpValue, Value);
+}
+
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, Model& Value)
+{
+	return Value.FromJson(JsonValue);
+}
+
+template<typename T, typename std::enable_if<!std::is_base_of<Model, T>::value, int>::type = 0>
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, T& Value)
+{
+	T TmpValue;
+	if (JsonValue->TryGetNumber(TmpValue))
+	{
+		Value = TmpValue;
+		return true;
+	}
+	else
+		return false;
+}
+
+template<typename T>
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TArray<T>& ArrayValue)
+{
+	const TArray<TSharedPtr<FJsonValue>>* JsonArray;
+	if (JsonValue->TryGetArray(JsonArray))
+	{
+		bool ParseSuccess = true;
+		const int32 Count = JsonArray->Num();
+		ArrayValue.Reset(Count);
+		for (int i = 0; i < Count; i++)
+		{
+			T TmpValue;
+			ParseSuccess &= TryGetJsonValue((*JsonArray)[i], TmpValue);
+			ArrayValue.Emplace(MoveTemp(TmpValue));
+		}
+		return ParseSuccess;
+	}
+	return false;
+}
+
+template<typename T>
+inline bool TryGetJsonValue(const TSharedPtr<FJsonValue>& JsonValue, TMap<FString, T>& MapValue)
+{
+	const TSharedPtr<FJsonObject>* Object;
+	if (JsonValue->TryGetObject(Object))
+	{
+		MapValue.Reset();
+		bool ParseSuccess = true;
+		for (const auto& It : (*Object)->Values)
+		{
+			T TmpValue;
+			ParseSuccess &= TryGetJsonValue(It.Value, TmpValue);
+			MapValue.Emplace(It.Key, MoveTemp(TmpValue));
+		}
+		return ParseSuccess;
+	}
+	return false;
+}
+
+template<typename T>
+inline bool TryGetJsonValue(const TSharedPtr<FJsonObject>& JsonObject, const FString& Key, T& Value)
+{
+	const TSharedPtr<FJsonValue> JsonValue = JsonObject->TryGetField(Key);
+	if (JsonValue.IsValid() && !JsonValue->IsNull())
+	{
+		return TryGetJsonValue(JsonValue, Value);
+	}
+	return false;
+}
+
+template<typename T>
+inline bool TryGetJsonValue(const TSharedPtr<FJsonObject>& JsonObject, const FString& Key, TOptional<T>& OptionalValue)
+{
+	if(JsonObject->HasField(Key))
+	{
+		T Value;
+		if (TryGetJsonValue(JsonObject, Key, Value))
+		{
+			OptionalValue = Value;
+			return true;
+		}
+		else
+			return false;
+	}
+	return true; // Absence of optional value is not a parsing error
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, FString& Value)
+{
+	return Reader.ReadString(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, FDateTime& Value)
+{
+	FString TmpValue;
+	return Reader.ReadString(TmpValue) && ParseDateTime(TmpValue, Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, FGuid& Value)
+{
+	FString TmpValue;
+	return Reader.ReadString(TmpValue) && FGuid::Parse(TmpValue, Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, TArray<uint8>& Value)
+{
+	return Reader.ReadBase64Url(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, bool& Value)
+{
+	return Reader.ReadBool(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, int32& Value)
+{
+	return Reader.ReadInt32(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, int64& Value)
+{
+	return Reader.ReadInt64(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, float& Value)
+{
+	double TmpValue;
+	if (Reader.ReadNumber(TmpValue))
+	{
+		Value = static_cast<float>(TmpValue);
+		return true;
+	}
+	else
+		return false;
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, double& Value)
+{
+	return Reader.ReadNumber(Value);
+}
+
+inline bool ReadJsonValue(JsonStreamReader& Reader, Model& Value)
+{
+	return Value.FromJsonStream(Reader);
+}
+
+template<typename T>
+inline bool ReadJsonValue(JsonStreamReader& Reader, TArray<T>& ArrayValue)
+{
+	if (!Reader.ReadArrayStart())
+		return false;
+
+	// The elements already in the array are decoded again in place, keeping their own allocations
+	bool ParseSuccess = true;
+	int32 Count = 0;
+	while (Reader.NextElement())
+	{
+		T& Element = Count < ArrayValue.Num() ? ArrayValue[Count] : ArrayValue.AddDefaulted_GetRef();
+		++Count;
+		ParseSuccess &= ReadJsonValue(Reader, Element);
+	}
+	ArrayValue.SetNum(Count, false);
+	return ParseSuccess && !Reader.HasError();
+}
+
+template<typename T>
+inline bool ReadJsonValue(JsonStreamReader& Reader, TMap<FString, T>& MapValue)
+{
+	if (!Reader.ReadObjectStart())
+		return false;
+
+	bool ParseSuccess = true;
+	MapValue.Reset();
+	while (Reader.NextField())
+	{
+		// The key has to be taken before the value is read, nested objects move it
+		FString Key = Reader.GetKey();
+		T TmpValue;
+		ParseSuccess &= ReadJsonValue(Reader, TmpValue);
+		MapValue.Emplace(MoveTemp(Key), MoveTemp(TmpValue));
+	}
+	return ParseSuccess && !Reader.HasError();
+}
+
+/* Reads the value of the current field, a null value is a parsing error like with TryGetJsonValue */
+template<typename T>
+inline bool ReadJsonField(JsonStreamReader& Reader, T& Value)
+{
+	if (Reader.TryReadNull())
+		return false;
+
+	return ReadJsonValue(Reader, Value);
+}
+
+template<typename T>
+inline bool ReadJsonField(JsonStreamReader& Reader, TOptional<T>& OptionalValue)
+{
+	if (Reader.TryReadNull())
+		return false;
+
+	// Decoded in place like the other fields
+	if (!OptionalValue.IsSet())
+	{
+		OptionalValue.Emplace();
+	}
+
+	if (ReadJsonValue(Reader, OptionalValue.GetValue()))
+		return true;
+
+	OptionalValue.Reset();
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+/* Binds the model field tables, see OpenAPIFieldTable.h, to the JSON helpers above */
+struct ModelFieldCodec
+{
+	typedef JsonStreamReader StreamReader;
+	typedef JsonWriter Writer;
+
+	template<typename T>
+	static bool Read(const TSharedPtr<FJsonValue>& JsonValue, T& Value) { return TryGetJsonValue(JsonValue, Value); }
+
+	template<typename T>
+	static bool Read(JsonStreamReader& Reader, T& Value) { return ReadJsonField(Reader, Value); }
+
+	template<typename T>
+	static void Write(JsonWriter& Writer, const T& Value) { WriteJsonValue(Writer, Value); }
+};
+
+template<typename ModelType>
+using ModelField = TModelField<ModelType, ModelFieldCodec>;
+
+}
@@ -24,6 +24,7 @@ public class IMSSessionManagerAPI : ModuleRules
                 "Core",
                 "Http",
                 "Json",
+                "IMSOpenAPIRuntime",
             }
         );
         PCHUsage = PCHUsageMode.NoPCHs;
@@ -20,32 +20,25 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIProtobufAny> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIProtobufAny, "type_url", TypeUrl),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIProtobufAny, "value", Value)
+};
+
 void OpenAPIProtobufAny::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (TypeUrl.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("type_url")); WriteJsonValue(Writer, TypeUrl.GetValue());
-	}
-	if (Value.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("value")); WriteJsonValue(Writer, Value.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIProtobufAny::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("type_url"), TypeUrl);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("value"), Value);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIProtobufAny::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
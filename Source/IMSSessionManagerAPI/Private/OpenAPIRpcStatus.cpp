@@ -20,37 +20,26 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIRpcStatus> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIRpcStatus, "code", Code),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIRpcStatus, "message", Message),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIRpcStatus, "details", Details)
+};
+
 void OpenAPIRpcStatus::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Code.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("code")); WriteJsonValue(Writer, Code.GetValue());
-	}
-	if (Message.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("message")); WriteJsonValue(Writer, Message.GetValue());
-	}
-	if (Details.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("details")); WriteJsonValue(Writer, Details.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIRpcStatus::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("code"), Code);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("message"), Message);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("details"), Details);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIRpcStatus::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -13,9 +13,12 @@
 #include "OpenAPISessionManagerV0Api.h"
 
 #include "OpenAPISessionManagerV0ApiOperations.h"
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIInstrumentation.h"
 #include "IMSSessionManagerAPIModule.h"
 
 #include "HttpModule.h"
+#include "Misc/ScopeExit.h"
 #include "Serialization/JsonSerializer.h"
 
 namespace IMSSessionManagerAPI
@@ -23,6 +26,7 @@ namespace IMSSessionManagerAPI
 
 OpenAPISessionManagerV0Api::OpenAPISessionManagerV0Api()
 : Url(TEXT("https://session-manager.ims.improbable.io"))
+, RequestsToken(IMSOpenAPI::MakeCancellationToken())
 {
 }
 
@@ -54,6 +58,16 @@ bool OpenAPISessionManagerV0Api::IsValid() const
 	return true;
 }
 
+void OpenAPISessionManagerV0Api::CancelAllRequests()
+{
+	// The requests that joined the cancelled ones are dropped with them
+	SingleFlight.Reset();
+
+	const IMSOpenAPI::FCancellationTokenRef CancelledToken = RequestsToken;
+	RequestsToken = IMSOpenAPI::MakeCancellationToken();
+	CancelledToken->Cancel();
+}
+
 void OpenAPISessionManagerV0Api::SetHttpRetryManager(FHttpRetrySystem::FManager& InRetryManager)
 {
 	if(RetryManager != &GetHttpRetryManager())
@@ -79,18 +93,45 @@ FHttpRequestRef OpenAPISessionManagerV0Api::CreateHttpRequest(const Request& Req
 	{
 		if (!RetryManager)
 		{
-			// Create default retry manager if none was specified
-			DefaultRetryManager = MakeUnique<HttpRetryManager>(6, 60);
+			// Use the default retry manager, shared with the other APIs, if none was specified
+			DefaultRetryManager = HttpRetryManager::GetShared();
 			RetryManager = DefaultRetryManager.Get();
 		}
 
+		// The retries stop at the deadline of the request
 		const HttpRetryParams& Params = Request.GetRetryParams().GetValue();
-		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, Params.RetryTimeoutRelativeSecondsOverride, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+		FRetryTimeoutRelativeSecondsSetting RetryTimeout = Params.RetryTimeoutRelativeSecondsOverride;
+		if (Request.GetDeadline().IsSet())
+		{
+			const double RemainingSeconds = FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001);
+			RetryTimeout = RetryTimeout.IsSet() ? FMath::Min(RetryTimeout.GetValue(), RemainingSeconds) : RemainingSeconds;
+		}
+
+		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, RetryTimeout, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+	}
+}
+
+bool OpenAPISessionManagerV0Api::TrackHttpRequest(const Request& Request, const FHttpRequestRef& HttpRequest) const
+{
+	if (Request.GetDeadline().IsSet())
+	{
+		HttpRequest->SetTimeout(static_cast<float>(FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001)));
 	}
+
+	return RequestsToken->Register(HttpRequest) && Request.RegisterHttpRequest(HttpRequest);
 }
 
-void OpenAPISessionManagerV0Api::HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
+void OpenAPISessionManagerV0Api::HandleResponse(const TCHAR* Operation, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_IMS_DecodeResponse);
+	CSV_SCOPED_TIMING_STAT(IMS, DecodeResponse);
+
+	const double DecodeStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		IMSOpenAPI::FInstrumentation::Get().RecordResponse(Operation, HttpRequest, HttpResponse, InOutResponse.IsSuccessful(), FPlatformTime::Seconds() - DecodeStartTime);
+	};
+
 	InOutResponse.SetHttpResponse(HttpResponse);
 	InOutResponse.SetSuccessful(bSucceeded);
 
@@ -106,6 +147,14 @@ void OpenAPISessionManagerV0Api::HandleResponse(FHttpResponsePtr HttpResponse, b
 		}
 		else if (ContentType.StartsWith(TEXT("application/json")) || ContentType.StartsWith("text/json"))
 		{
+			if (bJsonStreamDecoding && InOutResponse.SupportsJsonStream())
+			{
+				const TArray<uint8>& Body = HttpResponse->GetContent();
+				JsonStreamReader StreamReader(Body.GetData(), Body.Num());
+				if (InOutResponse.FromJsonStream(StreamReader))
+					return; // Successfully parsed
+			}
+
 			Content = HttpResponse->GetContentAsString();
 
 			TSharedPtr<FJsonValue> JsonValue;
@@ -135,11 +184,11 @@ void OpenAPISessionManagerV0Api::HandleResponse(FHttpResponsePtr HttpResponse, b
 
 FHttpRequestPtr OpenAPISessionManagerV0Api::CreateSessionV0(const CreateSessionV0Request& Request, const FCreateSessionV0Delegate& Delegate /*= FCreateSessionV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(Request.ComputeUrl(Url));
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -149,24 +198,41 @@ FHttpRequestPtr OpenAPISessionManagerV0Api::CreateSessionV0(const CreateSessionV
 	Request.SetupHttpRequest(HttpRequest);
 
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerV0Api::OnCreateSessionV0Response, Delegate);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
 void OpenAPISessionManagerV0Api::OnCreateSessionV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FCreateSessionV0Delegate Delegate) const
 {
-	CreateSessionV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<CreateSessionV0Response> PooledResponse(bResponsePooling ? &CreateSessionV0ResponsePool : nullptr);
+	CreateSessionV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("CreateSessionV0"), HttpRequest, HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
 FHttpRequestPtr OpenAPISessionManagerV0Api::ListSessionsV0(const ListSessionsV0Request& Request, const FListSessionsV0Delegate& Delegate /*= FListSessionsV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
+	const FString& RequestUrl = Request.ComputeUrl(Url);
+	FString SingleFlightKey;
+	if (bSingleFlight && !Request.IsCancellable())
+	{
+		SingleFlightKey = SingleFlightRequests::MakeKey(TEXT("GET"), RequestUrl, AdditionalHeaderParams);
+		FHttpRequestPtr InFlightRequest = SingleFlight.Join(SingleFlightKey, [Delegate](const Response& SharedResponse)
+		{
+			Delegate.ExecuteIfBound(static_cast<const ListSessionsV0Response&>(SharedResponse));
+		});
+		if (InFlightRequest.IsValid())
+			return InFlightRequest;
+	}
+
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(RequestUrl);
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -175,16 +241,34 @@ FHttpRequestPtr OpenAPISessionManagerV0Api::ListSessionsV0(const ListSessionsV0R
 
 	Request.SetupHttpRequest(HttpRequest);
 
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerV0Api::OnListSessionsV0Response, Delegate);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerV0Api::OnListSessionsV0Response, Delegate, SingleFlightKey);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
+	// Only registered once the request is certain to go out, a flight that never completes would hold its joiners forever
+	if (!SingleFlightKey.IsEmpty())
+	{
+		SingleFlight.Add(SingleFlightKey, HttpRequest);
+	}
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
-void OpenAPISessionManagerV0Api::OnListSessionsV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FListSessionsV0Delegate Delegate) const
+void OpenAPISessionManagerV0Api::OnListSessionsV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FListSessionsV0Delegate Delegate, FString SingleFlightKey) const
 {
-	ListSessionsV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<ListSessionsV0Response> PooledResponse(bResponsePooling ? &ListSessionsV0ResponsePool : nullptr);
+	ListSessionsV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("ListSessionsV0"), HttpRequest, HttpResponse, bSucceeded, Response);
+
+	// Taken out first so that identical requests issued from the delegates go out again
+	const TArray<SingleFlightRequests::FOnComplete> Joined = SingleFlightKey.IsEmpty() ? TArray<SingleFlightRequests::FOnComplete>() : SingleFlight.Complete(SingleFlightKey);
+
 	Delegate.ExecuteIfBound(Response);
+	for (const SingleFlightRequests::FOnComplete& OnComplete : Joined)
+	{
+		OnComplete(Response);
+	}
 }
 
 }
@@ -23,19 +23,14 @@
 namespace IMSSessionManagerAPI
 {
 
-FString OpenAPISessionManagerV0Api::CreateSessionV0Request::ComputePath() const
+void OpenAPISessionManagerV0Api::CreateSessionV0Request::AppendPath(FStringBuilderBase& Builder) const
 {
-	TMap<FString, FStringFormatArg> PathParams = { 
-	{ TEXT("project_id"), ToStringFormatArg(ProjectId) } };
+	Builder << TEXT("/api/v0/projects/");
+	AppendString(Builder, ProjectId);
+	Builder << TEXT("/sessions");
 
-	FString Path = FString::Format(TEXT("/api/v0/projects/{project_id}/sessions"), PathParams);
-
-	TArray<FString> QueryParams;
-	QueryParams.Add(FString(TEXT("session_type=")) + ToUrlString(SessionType));
-	Path += TCHAR('?');
-	Path += FString::Join(QueryParams, TEXT("&"));
-
-	return Path;
+	Builder << TEXT("?session_type=");
+	AppendUrlString(Builder, SessionType);
 }
 
 void OpenAPISessionManagerV0Api::CreateSessionV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -49,14 +44,13 @@ void OpenAPISessionManagerV0Api::CreateSessionV0Request::SetupHttpRequest(const
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
 		// Body parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
+		static int32 BodySizeHint = 0;
+		JsonBodyWriter BodyWriter(BodySizeHint);
 
-		WriteJsonValue(Writer, Body);
-		Writer->Close();
+		WriteJsonValue(BodyWriter.GetWriter(), Body);
 
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		BodyWriter.SetupHttpRequest(HttpRequest);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -104,19 +98,19 @@ bool OpenAPISessionManagerV0Api::CreateSessionV0Response::FromJson(const TShared
 	return TryGetJsonValue(JsonValue, Content);
 }
 
-FString OpenAPISessionManagerV0Api::ListSessionsV0Request::ComputePath() const
+bool OpenAPISessionManagerV0Api::CreateSessionV0Response::FromJsonStream(JsonStreamReader& Reader)
 {
-	TMap<FString, FStringFormatArg> PathParams = { 
-	{ TEXT("project_id"), ToStringFormatArg(ProjectId) } };
-
-	FString Path = FString::Format(TEXT("/api/v0/projects/{project_id}/sessions"), PathParams);
+	return ReadJsonValue(Reader, Content);
+}
 
-	TArray<FString> QueryParams;
-	QueryParams.Add(FString(TEXT("session_type=")) + ToUrlString(SessionType));
-	Path += TCHAR('?');
-	Path += FString::Join(QueryParams, TEXT("&"));
+void OpenAPISessionManagerV0Api::ListSessionsV0Request::AppendPath(FStringBuilderBase& Builder) const
+{
+	Builder << TEXT("/api/v0/projects/");
+	AppendString(Builder, ProjectId);
+	Builder << TEXT("/sessions");
 
-	return Path;
+	Builder << TEXT("?session_type=");
+	AppendUrlString(Builder, SessionType);
 }
 
 void OpenAPISessionManagerV0Api::ListSessionsV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -129,14 +123,7 @@ void OpenAPISessionManagerV0Api::ListSessionsV0Request::SetupHttpRequest(const F
 	// Default to Json Body request
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		//HttpRequest->SetContentAsString(JsonBody);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -182,4 +169,9 @@ bool OpenAPISessionManagerV0Api::ListSessionsV0Response::FromJson(const TSharedP
 	return TryGetJsonValue(JsonValue, Content);
 }
 
+bool OpenAPISessionManagerV0Api::ListSessionsV0Response::FromJsonStream(JsonStreamReader& Reader)
+{
+	return ReadJsonValue(Reader, Content);
+}
+
 }
@@ -20,27 +20,24 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIV0CreateSessionRequestBody> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0CreateSessionRequestBody, "session_config", SessionConfig)
+};
+
 void OpenAPIV0CreateSessionRequestBody::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (SessionConfig.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("session_config")); WriteJsonValue(Writer, SessionConfig.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIV0CreateSessionRequestBody::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("session_config"), SessionConfig);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIV0CreateSessionRequestBody::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -20,37 +20,26 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIV0CreateSessionResponse> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0CreateSessionResponse, "id", Id),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0CreateSessionResponse, "address", Address),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0CreateSessionResponse, "ports", Ports)
+};
+
 void OpenAPIV0CreateSessionResponse::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Id.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("id")); WriteJsonValue(Writer, Id.GetValue());
-	}
-	if (Address.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("address")); WriteJsonValue(Writer, Address.GetValue());
-	}
-	if (Ports.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("ports")); WriteJsonValue(Writer, Ports.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIV0CreateSessionResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("id"), Id);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("address"), Address);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("ports"), Ports);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIV0CreateSessionResponse::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
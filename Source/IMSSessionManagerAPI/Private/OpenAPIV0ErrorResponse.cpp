@@ -20,32 +20,25 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIV0ErrorResponse> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0ErrorResponse, "message", Message),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0ErrorResponse, "request_id", RequestId)
+};
+
 void OpenAPIV0ErrorResponse::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Message.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("message")); WriteJsonValue(Writer, Message.GetValue());
-	}
-	if (RequestId.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("request_id")); WriteJsonValue(Writer, RequestId.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIV0ErrorResponse::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("message"), Message);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("request_id"), RequestId);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIV0ErrorResponse::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
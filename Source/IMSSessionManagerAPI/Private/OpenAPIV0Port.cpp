@@ -20,26 +20,25 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIV0Port> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Port, "name", Name),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Port, "port", Port)
+};
+
 void OpenAPIV0Port::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("name")); WriteJsonValue(Writer, Name);
-	Writer->WriteIdentifierPrefix(TEXT("port")); WriteJsonValue(Writer, Port);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIV0Port::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("name"), Name);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("port"), Port);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIV0Port::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
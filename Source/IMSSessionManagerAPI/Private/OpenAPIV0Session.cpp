@@ -20,30 +20,27 @@
 namespace IMSSessionManagerAPI
 {
 
+static const ModelField<OpenAPIV0Session> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Session, "id", Id),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Session, "address", Address),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Session, "ports", Ports),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIV0Session, "session_status", SessionStatus)
+};
+
 void OpenAPIV0Session::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("id")); WriteJsonValue(Writer, Id);
-	Writer->WriteIdentifierPrefix(TEXT("address")); WriteJsonValue(Writer, Address);
-	Writer->WriteIdentifierPrefix(TEXT("ports")); WriteJsonValue(Writer, Ports);
-	Writer->WriteIdentifierPrefix(TEXT("session_status")); WriteJsonValue(Writer, SessionStatus);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIV0Session::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("id"), Id);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("address"), Address);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("ports"), Ports);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("session_status"), SessionStatus);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIV0Session::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -12,89 +12,21 @@
 
 #pragma once
 
-#include "Interfaces/IHttpRequest.h"
-#include "Interfaces/IHttpResponse.h"
-#include "Serialization/JsonWriter.h"
-#include "Dom/JsonObject.h"
-#include "HttpRetrySystem.h"
-#include "Containers/Ticker.h"
+#include "OpenAPIModel.h"
 
 namespace IMSSessionManagerAPI
 {
 
-typedef TSharedRef<TJsonWriter<>> JsonWriter;
+// The base classes are shared by the generated APIs, see IMSOpenAPIRuntime
 using namespace FHttpRetrySystem;
-
-struct IMSSESSIONMANAGERAPI_API HttpRetryManager : public FManager, public FTickerObjectBase
-{
-	using FManager::FManager;
-
-	bool Tick(float DeltaTime) final;
-};
-
-struct IMSSESSIONMANAGERAPI_API HttpRetryParams
-{
-	HttpRetryParams(
-		const FRetryLimitCountSetting& InRetryLimitCountOverride = FRetryLimitCountSetting(),
-		const FRetryTimeoutRelativeSecondsSetting& InRetryTimeoutRelativeSecondsOverride = FRetryTimeoutRelativeSecondsSetting(),
-		const FRetryResponseCodes& InRetryResponseCodes = FRetryResponseCodes(),
-		const FRetryVerbs& InRetryVerbs = FRetryVerbs(),
-		const FRetryDomainsPtr& InRetryDomains = FRetryDomainsPtr()
-	);
-
-	FRetryLimitCountSetting              RetryLimitCountOverride;
-	FRetryTimeoutRelativeSecondsSetting  RetryTimeoutRelativeSecondsOverride;
-	FRetryResponseCodes					 RetryResponseCodes;
-	FRetryVerbs                          RetryVerbs;
-	FRetryDomainsPtr					 RetryDomains;
-};
-
-class IMSSESSIONMANAGERAPI_API Model
-{
-public:
-	virtual ~Model() {}
-	virtual void WriteJson(JsonWriter& Writer) const = 0;
-	virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) = 0;
-};
-
-class IMSSESSIONMANAGERAPI_API Request
-{
-public:
-	virtual ~Request() {}
-	virtual void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const = 0;
-	virtual FString ComputePath() const = 0;
-
-	/* Enables retry and optionally sets a retry policy for this request */
-	void SetShouldRetry(const HttpRetryParams& Params = HttpRetryParams()) { RetryParams = Params; }
-	const TOptional<HttpRetryParams>& GetRetryParams() const { return RetryParams; }
-
-private:
-	TOptional<HttpRetryParams> RetryParams;
-};
-
-class IMSSESSIONMANAGERAPI_API Response
-{
-public:
-	virtual ~Response() {}
-	virtual bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) = 0;
-
-	void SetSuccessful(bool InSuccessful) { Successful = InSuccessful; }
-	bool IsSuccessful() const { return Successful; }
-
-	virtual void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode);
-	EHttpResponseCodes::Type GetHttpResponseCode() const { return ResponseCode; }
-
-	void SetResponseString(const FString& InResponseString) { ResponseString = InResponseString; }
-	const FString& GetResponseString() const { return ResponseString; }
-
-	void SetHttpResponse(const FHttpResponsePtr& InHttpResponse) { HttpResponse = InHttpResponse; }
-	const FHttpResponsePtr& GetHttpResponse() const { return HttpResponse; }
-
-private:
-	bool Successful;
-	EHttpResponseCodes::Type ResponseCode;
-	FString ResponseString;
-	FHttpResponsePtr HttpResponse;
-};
+using IMSOpenAPI::JsonWriter;
+using IMSOpenAPI::JsonStreamReader;
+using IMSOpenAPI::HttpRetryManager;
+using IMSOpenAPI::HttpRetryParams;
+using IMSOpenAPI::Model;
+using IMSOpenAPI::Request;
+using IMSOpenAPI::JsonBodyWriter;
+using IMSOpenAPI::Response;
+using IMSOpenAPI::SingleFlightRequests;
 
 }
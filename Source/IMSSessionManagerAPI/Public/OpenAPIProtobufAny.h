@@ -27,6 +27,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIProtobufAny : public Model
 public:
     virtual ~OpenAPIProtobufAny() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	TOptional<FString> TypeUrl;
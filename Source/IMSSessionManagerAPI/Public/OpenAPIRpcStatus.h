@@ -28,6 +28,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIRpcStatus : public Model
 public:
     virtual ~OpenAPIRpcStatus() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	TOptional<int32> Code;
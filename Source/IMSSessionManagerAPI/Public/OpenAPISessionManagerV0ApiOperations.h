@@ -33,7 +33,8 @@ class IMSSESSIONMANAGERAPI_API OpenAPISessionManagerV0Api::CreateSessionV0Reques
 public:
     virtual ~CreateSessionV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("CreateSessionV0"); }
 
 	/* project_id of the project to use. */
 	FString ProjectId;
@@ -49,6 +50,8 @@ public:
     virtual ~CreateSessionV0Response() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool SupportsJsonStream() const final { return true; }
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 
     OpenAPIV0CreateSessionResponse Content;
 };
@@ -62,7 +65,8 @@ class IMSSESSIONMANAGERAPI_API OpenAPISessionManagerV0Api::ListSessionsV0Request
 public:
     virtual ~ListSessionsV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("ListSessionsV0"); }
 
 	/* project_id of the project to use. */
 	FString ProjectId;
@@ -76,6 +80,8 @@ public:
     virtual ~ListSessionsV0Response() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool SupportsJsonStream() const final { return true; }
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 
     OpenAPIV0ListSessionsResponse Content;
 };
@@ -27,6 +27,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0CreateSessionRequestBody : public Model
 public:
     virtual ~OpenAPIV0CreateSessionRequestBody() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* session_config to set on the game server. */
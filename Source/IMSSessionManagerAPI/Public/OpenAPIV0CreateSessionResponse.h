@@ -28,6 +28,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0CreateSessionResponse : public Model
 public:
     virtual ~OpenAPIV0CreateSessionResponse() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* id of the reserved game server. */
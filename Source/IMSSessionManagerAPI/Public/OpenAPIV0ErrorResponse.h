@@ -27,6 +27,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0ErrorResponse : public Model
 public:
     virtual ~OpenAPIV0ErrorResponse() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Error details. */
@@ -28,6 +28,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0ListSessionsResponse : public Model
 public:
     virtual ~OpenAPIV0ListSessionsResponse() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* sessions holds list of game servers from matching proj id. */
@@ -27,6 +27,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0Port : public Model
 public:
     virtual ~OpenAPIV0Port() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* name of the port. */
@@ -28,6 +28,7 @@ class IMSSESSIONMANAGERAPI_API OpenAPIV0Session : public Model
 public:
     virtual ~OpenAPIV0Session() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* id is the payload id. */
@@ -24,6 +24,7 @@ public class IMSZeuzAPI : ModuleRules
                 "Core",
                 "Http",
                 "Json",
+                "IMSOpenAPIRuntime",
             }
         );
         PCHUsage = PCHUsageMode.NoPCHs;
@@ -20,32 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIErrorResponseV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIErrorResponseV0, "message", Message),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIErrorResponseV0, "request_id", RequestId)
+};
+
 void OpenAPIErrorResponseV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Message.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("message")); WriteJsonValue(Writer, Message.GetValue());
-	}
-	if (RequestId.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("request_id")); WriteJsonValue(Writer, RequestId.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIErrorResponseV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("message"), Message);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("request_id"), RequestId);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIErrorResponseV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
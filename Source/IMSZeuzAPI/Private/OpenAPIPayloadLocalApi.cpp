@@ -13,9 +13,12 @@
 #include "OpenAPIPayloadLocalApi.h"
 
 #include "OpenAPIPayloadLocalApiOperations.h"
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIInstrumentation.h"
 #include "IMSZeuzAPIModule.h"
 
 #include "HttpModule.h"
+#include "Misc/ScopeExit.h"
 #include "Serialization/JsonSerializer.h"
 
 namespace IMSZeuzAPI
@@ -23,6 +26,7 @@ namespace IMSZeuzAPI
 
 OpenAPIPayloadLocalApi::OpenAPIPayloadLocalApi()
 : Url(TEXT("http://$"))
+, RequestsToken(IMSOpenAPI::MakeCancellationToken())
 {
 }
 
@@ -54,9 +58,19 @@ bool OpenAPIPayloadLocalApi::IsValid() const
 	return true;
 }
 
+void OpenAPIPayloadLocalApi::CancelAllRequests()
+{
+	// The requests that joined the cancelled ones are dropped with them
+	SingleFlight.Reset();
+
+	const IMSOpenAPI::FCancellationTokenRef CancelledToken = RequestsToken;
+	RequestsToken = IMSOpenAPI::MakeCancellationToken();
+	CancelledToken->Cancel();
+}
+
 void OpenAPIPayloadLocalApi::SetHttpRetryManager(FHttpRetrySystem::FManager& InRetryManager)
 {
-	if(RetryManager != &GetHttpRetryManager())
+	if(RetryManager != &InRetryManager)
 	{
 		DefaultRetryManager.Reset();
 		RetryManager = &InRetryManager;
@@ -79,18 +93,45 @@ FHttpRequestRef OpenAPIPayloadLocalApi::CreateHttpRequest(const Request& Request
 	{
 		if (!RetryManager)
 		{
-			// Create default retry manager if none was specified
-			DefaultRetryManager = MakeUnique<HttpRetryManager>(6, 60);
+			// Use the default retry manager, shared with the other APIs, if none was specified
+			DefaultRetryManager = HttpRetryManager::GetShared();
 			RetryManager = DefaultRetryManager.Get();
 		}
 
+		// The retries stop at the deadline of the request
 		const HttpRetryParams& Params = Request.GetRetryParams().GetValue();
-		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, Params.RetryTimeoutRelativeSecondsOverride, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+		FRetryTimeoutRelativeSecondsSetting RetryTimeout = Params.RetryTimeoutRelativeSecondsOverride;
+		if (Request.GetDeadline().IsSet())
+		{
+			const double RemainingSeconds = FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001);
+			RetryTimeout = RetryTimeout.IsSet() ? FMath::Min(RetryTimeout.GetValue(), RemainingSeconds) : RemainingSeconds;
+		}
+
+		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, RetryTimeout, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+	}
+}
+
+bool OpenAPIPayloadLocalApi::TrackHttpRequest(const Request& Request, const FHttpRequestRef& HttpRequest) const
+{
+	if (Request.GetDeadline().IsSet())
+	{
+		HttpRequest->SetTimeout(static_cast<float>(FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001)));
 	}
+
+	return RequestsToken->Register(HttpRequest) && Request.RegisterHttpRequest(HttpRequest);
 }
 
-void OpenAPIPayloadLocalApi::HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
+void OpenAPIPayloadLocalApi::HandleResponse(const TCHAR* Operation, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_IMS_DecodeResponse);
+	CSV_SCOPED_TIMING_STAT(IMS, DecodeResponse);
+
+	const double DecodeStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		IMSOpenAPI::FInstrumentation::Get().RecordResponse(Operation, HttpRequest, HttpResponse, InOutResponse.IsSuccessful(), FPlatformTime::Seconds() - DecodeStartTime);
+	};
+
 	InOutResponse.SetHttpResponse(HttpResponse);
 	InOutResponse.SetSuccessful(bSucceeded);
 
@@ -106,6 +147,14 @@ void OpenAPIPayloadLocalApi::HandleResponse(FHttpResponsePtr HttpResponse, bool
 		}
 		else if (ContentType.StartsWith(TEXT("application/json")) || ContentType.StartsWith("text/json"))
 		{
+			if (bJsonStreamDecoding && InOutResponse.SupportsJsonStream())
+			{
+				const TArray<uint8>& Body = HttpResponse->GetContent();
+				JsonStreamReader StreamReader(Body.GetData(), Body.Num());
+				if (InOutResponse.FromJsonStream(StreamReader))
+					return; // Successfully parsed
+			}
+
 			Content = HttpResponse->GetContentAsString();
 
 			TSharedPtr<FJsonValue> JsonValue;
@@ -135,11 +184,24 @@ void OpenAPIPayloadLocalApi::HandleResponse(FHttpResponsePtr HttpResponse, bool
 
 FHttpRequestPtr OpenAPIPayloadLocalApi::GetPayloadV0(const GetPayloadV0Request& Request, const FGetPayloadV0Delegate& Delegate /*= FGetPayloadV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
+	const FString& RequestUrl = Request.ComputeUrl(Url);
+	FString SingleFlightKey;
+	if (bSingleFlight && !Request.IsCancellable())
+	{
+		SingleFlightKey = SingleFlightRequests::MakeKey(TEXT("GET"), RequestUrl, AdditionalHeaderParams);
+		FHttpRequestPtr InFlightRequest = SingleFlight.Join(SingleFlightKey, [Delegate](const Response& SharedResponse)
+		{
+			Delegate.ExecuteIfBound(static_cast<const GetPayloadV0Response&>(SharedResponse));
+		});
+		if (InFlightRequest.IsValid())
+			return InFlightRequest;
+	}
+
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(RequestUrl);
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -148,25 +210,43 @@ FHttpRequestPtr OpenAPIPayloadLocalApi::GetPayloadV0(const GetPayloadV0Request&
 
 	Request.SetupHttpRequest(HttpRequest);
 
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadLocalApi::OnGetPayloadV0Response, Delegate);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadLocalApi::OnGetPayloadV0Response, Delegate, SingleFlightKey);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
+	// Only registered once the request is certain to go out, a flight that never completes would hold its joiners forever
+	if (!SingleFlightKey.IsEmpty())
+	{
+		SingleFlight.Add(SingleFlightKey, HttpRequest);
+	}
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
-void OpenAPIPayloadLocalApi::OnGetPayloadV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetPayloadV0Delegate Delegate) const
+void OpenAPIPayloadLocalApi::OnGetPayloadV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetPayloadV0Delegate Delegate, FString SingleFlightKey) const
 {
-	GetPayloadV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<GetPayloadV0Response> PooledResponse(bResponsePooling ? &GetPayloadV0ResponsePool : nullptr);
+	GetPayloadV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("GetPayloadV0"), HttpRequest, HttpResponse, bSucceeded, Response);
+
+	// Taken out first so that identical requests issued from the delegates go out again
+	const TArray<SingleFlightRequests::FOnComplete> Joined = SingleFlightKey.IsEmpty() ? TArray<SingleFlightRequests::FOnComplete>() : SingleFlight.Complete(SingleFlightKey);
+
 	Delegate.ExecuteIfBound(Response);
+	for (const SingleFlightRequests::FOnComplete& OnComplete : Joined)
+	{
+		OnComplete(Response);
+	}
 }
 
 FHttpRequestPtr OpenAPIPayloadLocalApi::ReadyV0(const ReadyV0Request& Request, const FReadyV0Delegate& Delegate /*= FReadyV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(Request.ComputeUrl(Url));
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -176,24 +256,28 @@ FHttpRequestPtr OpenAPIPayloadLocalApi::ReadyV0(const ReadyV0Request& Request, c
 	Request.SetupHttpRequest(HttpRequest);
 
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadLocalApi::OnReadyV0Response, Delegate);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
 void OpenAPIPayloadLocalApi::OnReadyV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FReadyV0Delegate Delegate) const
 {
-	ReadyV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<ReadyV0Response> PooledResponse(bResponsePooling ? &ReadyV0ResponsePool : nullptr);
+	ReadyV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("ReadyV0"), HttpRequest, HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
 FHttpRequestPtr OpenAPIPayloadLocalApi::SetAnnotationV0(const SetAnnotationV0Request& Request, const FSetAnnotationV0Delegate& Delegate /*= FSetAnnotationV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(Request.ComputeUrl(Url));
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -203,24 +287,28 @@ FHttpRequestPtr OpenAPIPayloadLocalApi::SetAnnotationV0(const SetAnnotationV0Req
 	Request.SetupHttpRequest(HttpRequest);
 
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadLocalApi::OnSetAnnotationV0Response, Delegate);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
 void OpenAPIPayloadLocalApi::OnSetAnnotationV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FSetAnnotationV0Delegate Delegate) const
 {
-	SetAnnotationV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<SetAnnotationV0Response> PooledResponse(bResponsePooling ? &SetAnnotationV0ResponsePool : nullptr);
+	SetAnnotationV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("SetAnnotationV0"), HttpRequest, HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
 FHttpRequestPtr OpenAPIPayloadLocalApi::SetLabelV0(const SetLabelV0Request& Request, const FSetLabelV0Delegate& Delegate /*= FSetLabelV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(Request.ComputeUrl(Url));
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -230,14 +318,18 @@ FHttpRequestPtr OpenAPIPayloadLocalApi::SetLabelV0(const SetLabelV0Request& Requ
 	Request.SetupHttpRequest(HttpRequest);
 
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPIPayloadLocalApi::OnSetLabelV0Response, Delegate);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
 void OpenAPIPayloadLocalApi::OnSetLabelV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FSetLabelV0Delegate Delegate) const
 {
-	SetLabelV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<SetLabelV0Response> PooledResponse(bResponsePooling ? &SetLabelV0ResponsePool : nullptr);
+	SetLabelV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("SetLabelV0"), HttpRequest, HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
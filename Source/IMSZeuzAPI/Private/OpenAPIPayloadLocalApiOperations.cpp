@@ -23,10 +23,9 @@
 namespace IMSZeuzAPI
 {
 
-FString OpenAPIPayloadLocalApi::GetPayloadV0Request::ComputePath() const
+void OpenAPIPayloadLocalApi::GetPayloadV0Request::AppendPath(FStringBuilderBase& Builder) const
 {
-	FString Path(TEXT("/api/v0/payload"));
-	return Path;
+	Builder << TEXT("/api/v0/payload");
 }
 
 void OpenAPIPayloadLocalApi::GetPayloadV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -39,14 +38,7 @@ void OpenAPIPayloadLocalApi::GetPayloadV0Request::SetupHttpRequest(const FHttpRe
 	// Default to Json Body request
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		//HttpRequest->SetContentAsString(JsonBody);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -79,10 +71,14 @@ bool OpenAPIPayloadLocalApi::GetPayloadV0Response::FromJson(const TSharedPtr<FJs
 	return TryGetJsonValue(JsonValue, Content);
 }
 
-FString OpenAPIPayloadLocalApi::ReadyV0Request::ComputePath() const
+bool OpenAPIPayloadLocalApi::GetPayloadV0Response::FromJsonStream(JsonStreamReader& Reader)
 {
-	FString Path(TEXT("/api/v0/ready"));
-	return Path;
+	return ReadJsonValue(Reader, Content);
+}
+
+void OpenAPIPayloadLocalApi::ReadyV0Request::AppendPath(FStringBuilderBase& Builder) const
+{
+	Builder << TEXT("/api/v0/ready");
 }
 
 void OpenAPIPayloadLocalApi::ReadyV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -95,14 +91,10 @@ void OpenAPIPayloadLocalApi::ReadyV0Request::SetupHttpRequest(const FHttpRequest
 	// Default to Json Body request
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
+		// Form parameters, the body is an empty object
+		static const uint8 EmptyObject[] = { '{', '}' };
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		HttpRequest->SetContent(TArray<uint8>(EmptyObject, UE_ARRAY_COUNT(EmptyObject)));
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -135,10 +127,9 @@ bool OpenAPIPayloadLocalApi::ReadyV0Response::FromJson(const TSharedPtr<FJsonVal
 	return true;
 }
 
-FString OpenAPIPayloadLocalApi::SetAnnotationV0Request::ComputePath() const
+void OpenAPIPayloadLocalApi::SetAnnotationV0Request::AppendPath(FStringBuilderBase& Builder) const
 {
-	FString Path(TEXT("/api/v0/metadata/annotation"));
-	return Path;
+	Builder << TEXT("/api/v0/metadata/annotation");
 }
 
 void OpenAPIPayloadLocalApi::SetAnnotationV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -152,17 +143,16 @@ void OpenAPIPayloadLocalApi::SetAnnotationV0Request::SetupHttpRequest(const FHtt
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
 		// Body parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
+		static int32 BodySizeHint = 0;
+		JsonBodyWriter BodyWriter(BodySizeHint);
 
 		if (OpenAPISetAnnotationRequestV0.IsSet())
 		{
-			WriteJsonValue(Writer, OpenAPISetAnnotationRequestV0.GetValue());
+			WriteJsonValue(BodyWriter.GetWriter(), OpenAPISetAnnotationRequestV0.GetValue());
 		}
-		Writer->Close();
 
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		BodyWriter.SetupHttpRequest(HttpRequest);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -197,10 +187,9 @@ bool OpenAPIPayloadLocalApi::SetAnnotationV0Response::FromJson(const TSharedPtr<
 	return true;
 }
 
-FString OpenAPIPayloadLocalApi::SetLabelV0Request::ComputePath() const
+void OpenAPIPayloadLocalApi::SetLabelV0Request::AppendPath(FStringBuilderBase& Builder) const
 {
-	FString Path(TEXT("/api/v0/metadata/label"));
-	return Path;
+	Builder << TEXT("/api/v0/metadata/label");
 }
 
 void OpenAPIPayloadLocalApi::SetLabelV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -214,17 +203,16 @@ void OpenAPIPayloadLocalApi::SetLabelV0Request::SetupHttpRequest(const FHttpRequ
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
 		// Body parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
+		static int32 BodySizeHint = 0;
+		JsonBodyWriter BodyWriter(BodySizeHint);
 
 		if (OpenAPISetLabelRequestV0.IsSet())
 		{
-			WriteJsonValue(Writer, OpenAPISetLabelRequestV0.GetValue());
+			WriteJsonValue(BodyWriter.GetWriter(), OpenAPISetLabelRequestV0.GetValue());
 		}
-		Writer->Close();
 
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		BodyWriter.SetupHttpRequest(HttpRequest);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
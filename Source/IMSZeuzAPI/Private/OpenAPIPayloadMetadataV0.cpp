@@ -20,32 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPayloadMetadataV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadMetadataV0, "labels", Labels),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadMetadataV0, "annotations", Annotations)
+};
+
 void OpenAPIPayloadMetadataV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Labels.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("labels")); WriteJsonValue(Writer, Labels.GetValue());
-	}
-	if (Annotations.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("annotations")); WriteJsonValue(Writer, Annotations.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPayloadMetadataV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("labels"), Labels);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("annotations"), Annotations);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPayloadMetadataV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
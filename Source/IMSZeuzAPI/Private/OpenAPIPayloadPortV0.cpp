@@ -20,26 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPayloadPortV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadPortV0, "name", Name),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadPortV0, "port", Port)
+};
+
 void OpenAPIPayloadPortV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("name")); WriteJsonValue(Writer, Name);
-	Writer->WriteIdentifierPrefix(TEXT("port")); WriteJsonValue(Writer, Port);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPayloadPortV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("name"), Name);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("port"), Port);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPayloadPortV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
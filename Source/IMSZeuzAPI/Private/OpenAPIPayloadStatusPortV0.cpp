@@ -20,26 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPayloadStatusPortV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusPortV0, "name", Name),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusPortV0, "port", Port)
+};
+
 void OpenAPIPayloadStatusPortV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("name")); WriteJsonValue(Writer, Name);
-	Writer->WriteIdentifierPrefix(TEXT("port")); WriteJsonValue(Writer, Port);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPayloadStatusPortV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("name"), Name);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("port"), Port);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPayloadStatusPortV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -106,4 +106,10 @@ bool OpenAPIPayloadStatusStateV0::FromJson(const TSharedPtr<FJsonValue>& JsonVal
 	return TryGetJsonValue(JsonValue, Value);
 }
 
+bool OpenAPIPayloadStatusStateV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	FString TmpValue;
+	return Reader.ReadString(TmpValue) && FromString(TmpValue, Value);
+}
+
 }
@@ -20,49 +20,29 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPayloadStatusV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "state", State),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "details", Details),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "address", Address),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "ports", Ports),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "last_reserved", LastReserved),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadStatusV0, "started", Started)
+};
+
 void OpenAPIPayloadStatusV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("state")); WriteJsonValue(Writer, State);
-	if (Details.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("details")); WriteJsonValue(Writer, Details.GetValue());
-	}
-	if (Address.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("address")); WriteJsonValue(Writer, Address.GetValue());
-	}
-	if (Ports.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("ports")); WriteJsonValue(Writer, Ports.GetValue());
-	}
-	if (LastReserved.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("last_reserved")); WriteJsonValue(Writer, LastReserved.GetValue());
-	}
-	if (Started.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("started")); WriteJsonValue(Writer, Started.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPayloadStatusV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("state"), State);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("details"), Details);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("address"), Address);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("ports"), Ports);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("last_reserved"), LastReserved);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("started"), Started);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPayloadStatusV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
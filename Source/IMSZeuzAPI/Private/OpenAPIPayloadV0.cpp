@@ -20,34 +20,29 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPayloadV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "id", Id),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "cluster_id", ClusterId),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "allocation_id", AllocationId),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "status", Status),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "created", Created),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPayloadV0, "metadata", Metadata)
+};
+
 void OpenAPIPayloadV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("id")); WriteJsonValue(Writer, Id);
-	Writer->WriteIdentifierPrefix(TEXT("cluster_id")); WriteJsonValue(Writer, ClusterId);
-	Writer->WriteIdentifierPrefix(TEXT("allocation_id")); WriteJsonValue(Writer, AllocationId);
-	Writer->WriteIdentifierPrefix(TEXT("status")); WriteJsonValue(Writer, Status);
-	Writer->WriteIdentifierPrefix(TEXT("created")); WriteJsonValue(Writer, Created);
-	Writer->WriteIdentifierPrefix(TEXT("metadata")); WriteJsonValue(Writer, Metadata);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPayloadV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("id"), Id);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("cluster_id"), ClusterId);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("allocation_id"), AllocationId);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("status"), Status);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("created"), Created);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("metadata"), Metadata);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPayloadV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -20,31 +20,26 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIPortV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPortV0, "name", Name),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPortV0, "container_port", ContainerPort),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIPortV0, "protocol", Protocol)
+};
+
 void OpenAPIPortV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("name")); WriteJsonValue(Writer, Name);
-	Writer->WriteIdentifierPrefix(TEXT("container_port")); WriteJsonValue(Writer, ContainerPort);
-	if (Protocol.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("protocol")); WriteJsonValue(Writer, Protocol.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIPortV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("name"), Name);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("container_port"), ContainerPort);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("protocol"), Protocol);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIPortV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
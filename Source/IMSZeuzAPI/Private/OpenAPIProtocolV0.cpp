@@ -91,4 +91,10 @@ bool OpenAPIProtocolV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 	return TryGetJsonValue(JsonValue, Value);
 }
 
+bool OpenAPIProtocolV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	FString TmpValue;
+	return Reader.ReadString(TmpValue) && FromString(TmpValue, Value);
+}
+
 }
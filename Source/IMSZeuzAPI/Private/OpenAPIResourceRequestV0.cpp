@@ -20,26 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPIResourceRequestV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIResourceRequestV0, "cpu", Cpu),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPIResourceRequestV0, "memory", Memory)
+};
+
 void OpenAPIResourceRequestV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("cpu")); WriteJsonValue(Writer, Cpu);
-	Writer->WriteIdentifierPrefix(TEXT("memory")); WriteJsonValue(Writer, Memory);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPIResourceRequestV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("cpu"), Cpu);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("memory"), Memory);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPIResourceRequestV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
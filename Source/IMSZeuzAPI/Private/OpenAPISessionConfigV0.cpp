@@ -20,27 +20,24 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPISessionConfigV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPISessionConfigV0, "config", Config)
+};
+
 void OpenAPISessionConfigV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	if (Config.IsSet())
-	{
-		Writer->WriteIdentifierPrefix(TEXT("config")); WriteJsonValue(Writer, Config.GetValue());
-	}
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPISessionConfigV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("config"), Config);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPISessionConfigV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
@@ -13,9 +13,12 @@
 #include "OpenAPISessionManagerLocalApi.h"
 
 #include "OpenAPISessionManagerLocalApiOperations.h"
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIInstrumentation.h"
 #include "IMSZeuzAPIModule.h"
 
 #include "HttpModule.h"
+#include "Misc/ScopeExit.h"
 #include "Serialization/JsonSerializer.h"
 
 namespace IMSZeuzAPI
@@ -23,6 +26,7 @@ namespace IMSZeuzAPI
 
 OpenAPISessionManagerLocalApi::OpenAPISessionManagerLocalApi()
 : Url(TEXT("http://$"))
+, RequestsToken(IMSOpenAPI::MakeCancellationToken())
 {
 }
 
@@ -54,9 +58,19 @@ bool OpenAPISessionManagerLocalApi::IsValid() const
 	return true;
 }
 
+void OpenAPISessionManagerLocalApi::CancelAllRequests()
+{
+	// The requests that joined the cancelled ones are dropped with them
+	SingleFlight.Reset();
+
+	const IMSOpenAPI::FCancellationTokenRef CancelledToken = RequestsToken;
+	RequestsToken = IMSOpenAPI::MakeCancellationToken();
+	CancelledToken->Cancel();
+}
+
 void OpenAPISessionManagerLocalApi::SetHttpRetryManager(FHttpRetrySystem::FManager& InRetryManager)
 {
-	if(RetryManager != &GetHttpRetryManager())
+	if(RetryManager != &InRetryManager)
 	{
 		DefaultRetryManager.Reset();
 		RetryManager = &InRetryManager;
@@ -79,18 +93,45 @@ FHttpRequestRef OpenAPISessionManagerLocalApi::CreateHttpRequest(const Request&
 	{
 		if (!RetryManager)
 		{
-			// Create default retry manager if none was specified
-			DefaultRetryManager = MakeUnique<HttpRetryManager>(6, 60);
+			// Use the default retry manager, shared with the other APIs, if none was specified
+			DefaultRetryManager = HttpRetryManager::GetShared();
 			RetryManager = DefaultRetryManager.Get();
 		}
 
+		// The retries stop at the deadline of the request
 		const HttpRetryParams& Params = Request.GetRetryParams().GetValue();
-		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, Params.RetryTimeoutRelativeSecondsOverride, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+		FRetryTimeoutRelativeSecondsSetting RetryTimeout = Params.RetryTimeoutRelativeSecondsOverride;
+		if (Request.GetDeadline().IsSet())
+		{
+			const double RemainingSeconds = FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001);
+			RetryTimeout = RetryTimeout.IsSet() ? FMath::Min(RetryTimeout.GetValue(), RemainingSeconds) : RemainingSeconds;
+		}
+
+		return RetryManager->CreateRequest(Params.RetryLimitCountOverride, RetryTimeout, Params.RetryResponseCodes, Params.RetryVerbs, Params.RetryDomains);
+	}
+}
+
+bool OpenAPISessionManagerLocalApi::TrackHttpRequest(const Request& Request, const FHttpRequestRef& HttpRequest) const
+{
+	if (Request.GetDeadline().IsSet())
+	{
+		HttpRequest->SetTimeout(static_cast<float>(FMath::Max(Request.GetDeadline().GetValue() - FPlatformTime::Seconds(), 0.001)));
 	}
+
+	return RequestsToken->Register(HttpRequest) && Request.RegisterHttpRequest(HttpRequest);
 }
 
-void OpenAPISessionManagerLocalApi::HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
+void OpenAPISessionManagerLocalApi::HandleResponse(const TCHAR* Operation, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_IMS_DecodeResponse);
+	CSV_SCOPED_TIMING_STAT(IMS, DecodeResponse);
+
+	const double DecodeStartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		IMSOpenAPI::FInstrumentation::Get().RecordResponse(Operation, HttpRequest, HttpResponse, InOutResponse.IsSuccessful(), FPlatformTime::Seconds() - DecodeStartTime);
+	};
+
 	InOutResponse.SetHttpResponse(HttpResponse);
 	InOutResponse.SetSuccessful(bSucceeded);
 
@@ -106,6 +147,14 @@ void OpenAPISessionManagerLocalApi::HandleResponse(FHttpResponsePtr HttpResponse
 		}
 		else if (ContentType.StartsWith(TEXT("application/json")) || ContentType.StartsWith("text/json"))
 		{
+			if (bJsonStreamDecoding && InOutResponse.SupportsJsonStream())
+			{
+				const TArray<uint8>& Body = HttpResponse->GetContent();
+				JsonStreamReader StreamReader(Body.GetData(), Body.Num());
+				if (InOutResponse.FromJsonStream(StreamReader))
+					return; // Successfully parsed
+			}
+
 			Content = HttpResponse->GetContentAsString();
 
 			TSharedPtr<FJsonValue> JsonValue;
@@ -135,11 +184,24 @@ void OpenAPISessionManagerLocalApi::HandleResponse(FHttpResponsePtr HttpResponse
 
 FHttpRequestPtr OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGet(const ApiV0SessionManagerStatusGetRequest& Request, const FApiV0SessionManagerStatusGetDelegate& Delegate /*= FApiV0SessionManagerStatusGetDelegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
+	const FString& RequestUrl = Request.ComputeUrl(Url);
+	FString SingleFlightKey;
+	if (bSingleFlight && !Request.IsCancellable())
+	{
+		SingleFlightKey = SingleFlightRequests::MakeKey(TEXT("GET"), RequestUrl, AdditionalHeaderParams);
+		FHttpRequestPtr InFlightRequest = SingleFlight.Join(SingleFlightKey, [Delegate](const Response& SharedResponse)
+		{
+			Delegate.ExecuteIfBound(static_cast<const ApiV0SessionManagerStatusGetResponse&>(SharedResponse));
+		});
+		if (InFlightRequest.IsValid())
+			return InFlightRequest;
+	}
+
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(RequestUrl);
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -148,25 +210,43 @@ FHttpRequestPtr OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGet(cons
 
 	Request.SetupHttpRequest(HttpRequest);
 
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusGetResponse, Delegate);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusGetResponse, Delegate, SingleFlightKey);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
+	// Only registered once the request is certain to go out, a flight that never completes would hold its joiners forever
+	if (!SingleFlightKey.IsEmpty())
+	{
+		SingleFlight.Add(SingleFlightKey, HttpRequest);
+	}
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
-void OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusGetResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusGetDelegate Delegate) const
+void OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusGetResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusGetDelegate Delegate, FString SingleFlightKey) const
 {
-	ApiV0SessionManagerStatusGetResponse Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<ApiV0SessionManagerStatusGetResponse> PooledResponse(bResponsePooling ? &ApiV0SessionManagerStatusGetResponsePool : nullptr);
+	ApiV0SessionManagerStatusGetResponse& Response = PooledResponse.Get();
+	HandleResponse(TEXT("ApiV0SessionManagerStatusGet"), HttpRequest, HttpResponse, bSucceeded, Response);
+
+	// Taken out first so that identical requests issued from the delegates go out again
+	const TArray<SingleFlightRequests::FOnComplete> Joined = SingleFlightKey.IsEmpty() ? TArray<SingleFlightRequests::FOnComplete>() : SingleFlight.Complete(SingleFlightKey);
+
 	Delegate.ExecuteIfBound(Response);
+	for (const SingleFlightRequests::FOnComplete& OnComplete : Joined)
+	{
+		OnComplete(Response);
+	}
 }
 
 FHttpRequestPtr OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPost(const ApiV0SessionManagerStatusPostRequest& Request, const FApiV0SessionManagerStatusPostDelegate& Delegate /*= FApiV0SessionManagerStatusPostDelegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(Request.ComputeUrl(Url));
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -176,24 +256,41 @@ FHttpRequestPtr OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPost(con
 	Request.SetupHttpRequest(HttpRequest);
 
 	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusPostResponse, Delegate);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
 void OpenAPISessionManagerLocalApi::OnApiV0SessionManagerStatusPostResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusPostDelegate Delegate) const
 {
-	ApiV0SessionManagerStatusPostResponse Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<ApiV0SessionManagerStatusPostResponse> PooledResponse(bResponsePooling ? &ApiV0SessionManagerStatusPostResponsePool : nullptr);
+	ApiV0SessionManagerStatusPostResponse& Response = PooledResponse.Get();
+	HandleResponse(TEXT("ApiV0SessionManagerStatusPost"), HttpRequest, HttpResponse, bSucceeded, Response);
 	Delegate.ExecuteIfBound(Response);
 }
 
 FHttpRequestPtr OpenAPISessionManagerLocalApi::GetSessionConfigV0(const GetSessionConfigV0Request& Request, const FGetSessionConfigV0Delegate& Delegate /*= FGetSessionConfigV0Delegate()*/) const
 {
-	if (!IsValid())
+	if (!IsValid() || Request.IsCancelled() || Request.HasDeadlinePassed())
 		return nullptr;
 
+	const FString& RequestUrl = Request.ComputeUrl(Url);
+	FString SingleFlightKey;
+	if (bSingleFlight && !Request.IsCancellable())
+	{
+		SingleFlightKey = SingleFlightRequests::MakeKey(TEXT("GET"), RequestUrl, AdditionalHeaderParams);
+		FHttpRequestPtr InFlightRequest = SingleFlight.Join(SingleFlightKey, [Delegate](const Response& SharedResponse)
+		{
+			Delegate.ExecuteIfBound(static_cast<const GetSessionConfigV0Response&>(SharedResponse));
+		});
+		if (InFlightRequest.IsValid())
+			return InFlightRequest;
+	}
+
 	FHttpRequestRef HttpRequest = CreateHttpRequest(Request);
-	HttpRequest->SetURL(*(Url + Request.ComputePath()));
+	HttpRequest->SetURL(RequestUrl);
 
 	for(const auto& It : AdditionalHeaderParams)
 	{
@@ -202,16 +299,34 @@ FHttpRequestPtr OpenAPISessionManagerLocalApi::GetSessionConfigV0(const GetSessi
 
 	Request.SetupHttpRequest(HttpRequest);
 
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerLocalApi::OnGetSessionConfigV0Response, Delegate);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &OpenAPISessionManagerLocalApi::OnGetSessionConfigV0Response, Delegate, SingleFlightKey);
+	if (!TrackHttpRequest(Request, HttpRequest))
+		return nullptr;
+
+	// Only registered once the request is certain to go out, a flight that never completes would hold its joiners forever
+	if (!SingleFlightKey.IsEmpty())
+	{
+		SingleFlight.Add(SingleFlightKey, HttpRequest);
+	}
+
 	HttpRequest->ProcessRequest();
 	return HttpRequest;
 }
 
-void OpenAPISessionManagerLocalApi::OnGetSessionConfigV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetSessionConfigV0Delegate Delegate) const
+void OpenAPISessionManagerLocalApi::OnGetSessionConfigV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetSessionConfigV0Delegate Delegate, FString SingleFlightKey) const
 {
-	GetSessionConfigV0Response Response;
-	HandleResponse(HttpResponse, bSucceeded, Response);
+	IMSOpenAPI::TPooledResponse<GetSessionConfigV0Response> PooledResponse(bResponsePooling ? &GetSessionConfigV0ResponsePool : nullptr);
+	GetSessionConfigV0Response& Response = PooledResponse.Get();
+	HandleResponse(TEXT("GetSessionConfigV0"), HttpRequest, HttpResponse, bSucceeded, Response);
+
+	// Taken out first so that identical requests issued from the delegates go out again
+	const TArray<SingleFlightRequests::FOnComplete> Joined = SingleFlightKey.IsEmpty() ? TArray<SingleFlightRequests::FOnComplete>() : SingleFlight.Complete(SingleFlightKey);
+
 	Delegate.ExecuteIfBound(Response);
+	for (const SingleFlightRequests::FOnComplete& OnComplete : Joined)
+	{
+		OnComplete(Response);
+	}
 }
 
 }
@@ -23,10 +23,9 @@
 namespace IMSZeuzAPI
 {
 
-FString OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetRequest::ComputePath() const
+void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetRequest::AppendPath(FStringBuilderBase& Builder) const
 {
-	FString Path(TEXT("/api/v0/session-manager/status"));
-	return Path;
+	Builder << TEXT("/api/v0/session-manager/status");
 }
 
 void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -39,14 +38,7 @@ void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetRequest::SetupHt
 	// Default to Json Body request
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		//HttpRequest->SetContentAsString(JsonBody);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -76,10 +68,14 @@ bool OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetResponse::FromJs
 	return TryGetJsonValue(JsonValue, Content);
 }
 
-FString OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest::ComputePath() const
+bool OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGetResponse::FromJsonStream(JsonStreamReader& Reader)
 {
-	FString Path(TEXT("/api/v0/session-manager/status"));
-	return Path;
+	return ReadJsonValue(Reader, Content);
+}
+
+void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest::AppendPath(FStringBuilderBase& Builder) const
+{
+	Builder << TEXT("/api/v0/session-manager/status");
 }
 
 void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -93,17 +89,16 @@ void OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest::SetupH
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
 		// Body parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
+		static int32 BodySizeHint = 0;
+		JsonBodyWriter BodyWriter(BodySizeHint);
 
 		if (RequestBody.IsSet())
 		{
-			WriteJsonValue(Writer, RequestBody.GetValue());
+			WriteJsonValue(BodyWriter.GetWriter(), RequestBody.GetValue());
 		}
-		Writer->Close();
 
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		HttpRequest->SetContentAsString(JsonBody);
+		BodyWriter.SetupHttpRequest(HttpRequest);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -138,10 +133,9 @@ bool OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse::FromJ
 	return true;
 }
 
-FString OpenAPISessionManagerLocalApi::GetSessionConfigV0Request::ComputePath() const
+void OpenAPISessionManagerLocalApi::GetSessionConfigV0Request::AppendPath(FStringBuilderBase& Builder) const
 {
-	FString Path(TEXT("/api/v0/session-manager/config"));
-	return Path;
+	Builder << TEXT("/api/v0/session-manager/config");
 }
 
 void OpenAPISessionManagerLocalApi::GetSessionConfigV0Request::SetupHttpRequest(const FHttpRequestRef& HttpRequest) const
@@ -154,14 +148,7 @@ void OpenAPISessionManagerLocalApi::GetSessionConfigV0Request::SetupHttpRequest(
 	// Default to Json Body request
 	if (Consumes.Num() == 0 || Consumes.Contains(TEXT("application/json")))
 	{
-		// Form parameters
-		FString JsonBody;
-		JsonWriter Writer = TJsonWriterFactory<>::Create(&JsonBody);
-		Writer->WriteObjectStart();
-		Writer->WriteObjectEnd();
-		Writer->Close();
 		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json; charset=utf-8"));
-		//HttpRequest->SetContentAsString(JsonBody);
 	}
 	else if (Consumes.Contains(TEXT("multipart/form-data")))
 	{
@@ -191,4 +178,9 @@ bool OpenAPISessionManagerLocalApi::GetSessionConfigV0Response::FromJson(const T
 	return TryGetJsonValue(JsonValue, Content);
 }
 
+bool OpenAPISessionManagerLocalApi::GetSessionConfigV0Response::FromJsonStream(JsonStreamReader& Reader)
+{
+	return ReadJsonValue(Reader, Content);
+}
+
 }
@@ -20,26 +20,25 @@
 namespace IMSZeuzAPI
 {
 
+static const ModelField<OpenAPISetLabelRequestV0> Fields[] =
+{
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPISetLabelRequestV0, "key", Key),
+	OPENAPI_MODEL_FIELD(ModelFieldCodec, OpenAPISetLabelRequestV0, "value", Value)
+};
+
 void OpenAPISetLabelRequestV0::WriteJson(JsonWriter& Writer) const
 {
-	Writer->WriteObjectStart();
-	Writer->WriteIdentifierPrefix(TEXT("key")); WriteJsonValue(Writer, Key);
-	Writer->WriteIdentifierPrefix(TEXT("value")); WriteJsonValue(Writer, Value);
-	Writer->WriteObjectEnd();
+	IMSOpenAPI::WriteModel(*this, Fields, Writer);
 }
 
 bool OpenAPISetLabelRequestV0::FromJson(const TSharedPtr<FJsonValue>& JsonValue)
 {
-	const TSharedPtr<FJsonObject>* Object;
-	if (!JsonValue->TryGetObject(Object))
-		return false;
-
-	bool ParseSuccess = true;
-
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("key"), Key);
-	ParseSuccess &= TryGetJsonValue(*Object, TEXT("value"), Value);
+	return IMSOpenAPI::ReadModel(*this, Fields, JsonValue);
+}
 
-	return ParseSuccess;
+bool OpenAPISetLabelRequestV0::FromJsonStream(JsonStreamReader& Reader)
+{
+	return IMSOpenAPI::ReadModel(*this, Fields, Reader);
 }
 
 }
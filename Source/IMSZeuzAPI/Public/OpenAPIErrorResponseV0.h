@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIErrorResponseV0 : public Model
 public:
     virtual ~OpenAPIErrorResponseV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Human readable error details. */
@@ -28,6 +28,7 @@ class IMSZEUZAPI_API OpenAPIGetPayloadResponseV0 : public Model
 public:
     virtual ~OpenAPIGetPayloadResponseV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	OpenAPIPayloadV0 Result;
@@ -38,6 +38,22 @@ public:
 	void SetHttpRetryManager(FHttpRetrySystem::FManager& RetryManager);
 	FHttpRetrySystem::FManager& GetHttpRetryManager();
 
+	/* Decodes JSON responses straight from their UTF-8 body when they support it, see JsonStreamReader. Enabled by default,
+	* responses that fail to decode that way are decoded again through the FJsonValue DOM */
+	void SetJsonStreamDecoding(bool bEnabled) { bJsonStreamDecoding = bEnabled; }
+
+	/* Identical GET requests join the one in flight and share its response, see SingleFlightRequests. Enabled by default */
+	void SetSingleFlight(bool bEnabled) { bSingleFlight = bEnabled; }
+
+	/* Keeps the response of each operation between its calls and decodes replies into it in place, see TResponsePool.
+	* Disabled by default, delegates have to copy what they keep from the response when it is enabled */
+	void SetResponsePooling(bool bEnabled) { bResponsePooling = bEnabled; }
+
+	/* Cancels the requests in flight, their delegates are not called. Requests still in flight are also cancelled when
+	* the API is destroyed. Cancelling a single request or bounding its duration is done with Request::SetCancellationToken
+	* and Request::SetDeadline */
+	void CancelAllRequests();
+
 	class GetPayloadV0Request;
 	class GetPayloadV0Response;
 	class ReadyV0Request;
@@ -58,19 +74,29 @@ public:
     FHttpRequestPtr SetLabelV0(const SetLabelV0Request& Request, const FSetLabelV0Delegate& Delegate = FSetLabelV0Delegate()) const;
     
 private:
-    void OnGetPayloadV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetPayloadV0Delegate Delegate) const;
+    void OnGetPayloadV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetPayloadV0Delegate Delegate, FString SingleFlightKey) const;
     void OnReadyV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FReadyV0Delegate Delegate) const;
     void OnSetAnnotationV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FSetAnnotationV0Delegate Delegate) const;
     void OnSetLabelV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FSetLabelV0Delegate Delegate) const;
     
 	FHttpRequestRef CreateHttpRequest(const Request& Request) const;
 	bool IsValid() const;
-	void HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
+	bool TrackHttpRequest(const Request& Request, const FHttpRequestRef& HttpRequest) const;
+	void HandleResponse(const TCHAR* Operation, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
 
 	FString Url;
 	TMap<FString,FString> AdditionalHeaderParams;
 	mutable FHttpRetrySystem::FManager* RetryManager = nullptr;
-	mutable TUniquePtr<HttpRetryManager> DefaultRetryManager;
+	mutable TSharedPtr<HttpRetryManager> DefaultRetryManager;
+	bool bJsonStreamDecoding = true;
+	bool bSingleFlight = true;
+	bool bResponsePooling = false;
+	mutable SingleFlightRequests SingleFlight;
+	IMSOpenAPI::FCancellationTokenRef RequestsToken;
+	mutable IMSOpenAPI::TResponsePool<GetPayloadV0Response> GetPayloadV0ResponsePool;
+	mutable IMSOpenAPI::TResponsePool<ReadyV0Response> ReadyV0ResponsePool;
+	mutable IMSOpenAPI::TResponsePool<SetAnnotationV0Response> SetAnnotationV0ResponsePool;
+	mutable IMSOpenAPI::TResponsePool<SetLabelV0Response> SetLabelV0ResponsePool;
 };
 
 }
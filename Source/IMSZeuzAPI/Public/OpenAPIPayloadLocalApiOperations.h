@@ -32,7 +32,8 @@ class IMSZEUZAPI_API OpenAPIPayloadLocalApi::GetPayloadV0Request : public Reques
 public:
     virtual ~GetPayloadV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("GetPayloadV0"); }
 
 };
 
@@ -42,6 +43,8 @@ public:
     virtual ~GetPayloadV0Response() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool SupportsJsonStream() const final { return true; }
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 
     OpenAPIGetPayloadResponseV0 Content;
 };
@@ -55,7 +58,8 @@ class IMSZEUZAPI_API OpenAPIPayloadLocalApi::ReadyV0Request : public Request
 public:
     virtual ~ReadyV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("ReadyV0"); }
 
 };
 
@@ -78,7 +82,8 @@ class IMSZEUZAPI_API OpenAPIPayloadLocalApi::SetAnnotationV0Request : public Req
 public:
     virtual ~SetAnnotationV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("SetAnnotationV0"); }
 
 	TOptional<OpenAPISetAnnotationRequestV0> OpenAPISetAnnotationRequestV0;
 };
@@ -102,7 +107,8 @@ class IMSZEUZAPI_API OpenAPIPayloadLocalApi::SetLabelV0Request : public Request
 public:
     virtual ~SetLabelV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("SetLabelV0"); }
 
 	TOptional<OpenAPISetLabelRequestV0> OpenAPISetLabelRequestV0;
 };
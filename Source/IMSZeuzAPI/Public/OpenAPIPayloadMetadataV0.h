@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIPayloadMetadataV0 : public Model
 public:
     virtual ~OpenAPIPayloadMetadataV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* labels contains key-value pairs of identifying metadata. A valid label key:  - must be 59 characters or less (cannot be empty),  - must begin and end with an alphanumeric character ([a-z0-9A-Z]),  - could contain dashes (-), underscores (_), dots (.), and alphanumerics between. A valid label value:  - must be 63 characters or less (can be empty),  - unless empty, must begin and end with an alphanumeric character ([a-z0-9A-Z]),  - could contain dashes (-), underscores (_), dots (.), and alphanumerics between. Labels can be used to identify payloads, e.g. a reservation request can filter payloads based on their labels. */
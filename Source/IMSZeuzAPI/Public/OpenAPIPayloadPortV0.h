@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIPayloadPortV0 : public Model
 public:
     virtual ~OpenAPIPayloadPortV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Port name, as defined in the payload specification. */
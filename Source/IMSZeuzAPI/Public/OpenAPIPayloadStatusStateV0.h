@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIPayloadStatusStateV0 : public Model
 public:
     virtual ~OpenAPIPayloadStatusStateV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	enum class Values
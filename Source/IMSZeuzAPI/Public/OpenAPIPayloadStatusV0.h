@@ -29,6 +29,7 @@ class IMSZEUZAPI_API OpenAPIPayloadStatusV0 : public Model
 public:
     virtual ~OpenAPIPayloadStatusV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	OpenAPIPayloadStatusStateV0 State;
@@ -29,6 +29,7 @@ class IMSZEUZAPI_API OpenAPIPayloadV0 : public Model
 public:
     virtual ~OpenAPIPayloadV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Payload identifier, unique for this allocation/cluster at this point in time. */
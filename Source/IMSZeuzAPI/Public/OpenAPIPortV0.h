@@ -28,6 +28,7 @@ class IMSZEUZAPI_API OpenAPIPortV0 : public Model
 public:
     virtual ~OpenAPIPortV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Name of the port. */
@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIProtocolV0 : public Model
 public:
     virtual ~OpenAPIProtocolV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	enum class Values
@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPIResourceRequestV0 : public Model
 public:
     virtual ~OpenAPIResourceRequestV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* Amount of CPU, in milliCPU. For example: \"500m\" allocates 0.5 CPU. */
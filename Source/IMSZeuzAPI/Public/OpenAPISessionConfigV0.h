@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPISessionConfigV0 : public Model
 public:
     virtual ~OpenAPISessionConfigV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	TOptional<FString> Config;
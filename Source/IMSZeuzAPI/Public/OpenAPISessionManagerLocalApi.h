@@ -38,6 +38,22 @@ public:
 	void SetHttpRetryManager(FHttpRetrySystem::FManager& RetryManager);
 	FHttpRetrySystem::FManager& GetHttpRetryManager();
 
+	/* Decodes JSON responses straight from their UTF-8 body when they support it, see JsonStreamReader. Enabled by default,
+	* responses that fail to decode that way are decoded again through the FJsonValue DOM */
+	void SetJsonStreamDecoding(bool bEnabled) { bJsonStreamDecoding = bEnabled; }
+
+	/* Identical GET requests join the one in flight and share its response, see SingleFlightRequests. Enabled by default */
+	void SetSingleFlight(bool bEnabled) { bSingleFlight = bEnabled; }
+
+	/* Keeps the response of each operation between its calls and decodes replies into it in place, see TResponsePool.
+	* Disabled by default, delegates have to copy what they keep from the response when it is enabled */
+	void SetResponsePooling(bool bEnabled) { bResponsePooling = bEnabled; }
+
+	/* Cancels the requests in flight, their delegates are not called. Requests still in flight are also cancelled when
+	* the API is destroyed. Cancelling a single request or bounding its duration is done with Request::SetCancellationToken
+	* and Request::SetDeadline */
+	void CancelAllRequests();
+
 	class ApiV0SessionManagerStatusGetRequest;
 	class ApiV0SessionManagerStatusGetResponse;
 	class ApiV0SessionManagerStatusPostRequest;
@@ -54,18 +70,27 @@ public:
     FHttpRequestPtr GetSessionConfigV0(const GetSessionConfigV0Request& Request, const FGetSessionConfigV0Delegate& Delegate = FGetSessionConfigV0Delegate()) const;
     
 private:
-    void OnApiV0SessionManagerStatusGetResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusGetDelegate Delegate) const;
+    void OnApiV0SessionManagerStatusGetResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusGetDelegate Delegate, FString SingleFlightKey) const;
     void OnApiV0SessionManagerStatusPostResponse(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FApiV0SessionManagerStatusPostDelegate Delegate) const;
-    void OnGetSessionConfigV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetSessionConfigV0Delegate Delegate) const;
+    void OnGetSessionConfigV0Response(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FGetSessionConfigV0Delegate Delegate, FString SingleFlightKey) const;
     
 	FHttpRequestRef CreateHttpRequest(const Request& Request) const;
 	bool IsValid() const;
-	void HandleResponse(FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
+	bool TrackHttpRequest(const Request& Request, const FHttpRequestRef& HttpRequest) const;
+	void HandleResponse(const TCHAR* Operation, FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, Response& InOutResponse) const;
 
 	FString Url;
 	TMap<FString,FString> AdditionalHeaderParams;
 	mutable FHttpRetrySystem::FManager* RetryManager = nullptr;
-	mutable TUniquePtr<HttpRetryManager> DefaultRetryManager;
+	mutable TSharedPtr<HttpRetryManager> DefaultRetryManager;
+	bool bJsonStreamDecoding = true;
+	bool bSingleFlight = true;
+	bool bResponsePooling = false;
+	mutable SingleFlightRequests SingleFlight;
+	IMSOpenAPI::FCancellationTokenRef RequestsToken;
+	mutable IMSOpenAPI::TResponsePool<ApiV0SessionManagerStatusGetResponse> ApiV0SessionManagerStatusGetResponsePool;
+	mutable IMSOpenAPI::TResponsePool<ApiV0SessionManagerStatusPostResponse> ApiV0SessionManagerStatusPostResponsePool;
+	mutable IMSOpenAPI::TResponsePool<GetSessionConfigV0Response> GetSessionConfigV0ResponsePool;
 };
 
 }
@@ -28,7 +28,8 @@ class IMSZEUZAPI_API OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusGet
 public:
     virtual ~ApiV0SessionManagerStatusGetRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("ApiV0SessionManagerStatusGet"); }
 
 };
 
@@ -38,6 +39,8 @@ public:
     virtual ~ApiV0SessionManagerStatusGetResponse() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool SupportsJsonStream() const final { return true; }
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 
     TMap<FString, FString> Content;
 };
@@ -50,7 +53,8 @@ class IMSZEUZAPI_API OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPos
 public:
     virtual ~ApiV0SessionManagerStatusPostRequest() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("ApiV0SessionManagerStatusPost"); }
 
 	TOptional<TMap<FString, FString>> RequestBody;
 };
@@ -74,7 +78,8 @@ class IMSZEUZAPI_API OpenAPISessionManagerLocalApi::GetSessionConfigV0Request :
 public:
     virtual ~GetSessionConfigV0Request() {}
 	void SetupHttpRequest(const FHttpRequestRef& HttpRequest) const final;
-	FString ComputePath() const final;
+	void AppendPath(FStringBuilderBase& Builder) const final;
+	const TCHAR* GetOperationName() const final { return TEXT("GetSessionConfigV0"); }
 
 };
 
@@ -84,6 +89,8 @@ public:
     virtual ~GetSessionConfigV0Response() {}
 	void SetHttpResponseCode(EHttpResponseCodes::Type InHttpResponseCode) final;
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool SupportsJsonStream() const final { return true; }
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 
     OpenAPISessionConfigV0 Content;
 };
@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPISetAnnotationRequestV0 : public Model
 public:
     virtual ~OpenAPISetAnnotationRequestV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* A valid annotation key:  - must be 59 characters or less (cannot be empty),  - must begin and end with an alphanumeric character ([a-z0-9A-Z]),  - could contain dashes (-), underscores (_), dots (.), and alphanumerics between. */
@@ -27,6 +27,7 @@ class IMSZEUZAPI_API OpenAPISetLabelRequestV0 : public Model
 public:
     virtual ~OpenAPISetLabelRequestV0() {}
 	bool FromJson(const TSharedPtr<FJsonValue>& JsonValue) final;
+	bool FromJsonStream(JsonStreamReader& Reader) final;
 	void WriteJson(JsonWriter& Writer) const final;
 
 	/* A valid label key:  - must be 59 characters or less (cannot be empty),  - must begin and end with an alphanumeric character ([a-z0-9A-Z]),  - could contain dashes (-), underscores (_), dots (.), and alphanumerics between. */
@@ -8,7 +8,11 @@
 #include "Online/ShooterGameMode.h"
 #include "Online/ShooterPlayerState.h"
 #include "Online/ShooterGameSession.h"
+#include "Online/ShooterPayloadLocalApiMock.h"
+#include "Online/ShooterSessionConfig.h"
 #include "Bots/ShooterAIController.h"
+#include "Pickups/ShooterPickup.h"
+#include "BrainComponent.h"
 #include "Math/UnrealMathUtility.h"
 #include "ShooterTeamStart.h"
 
@@ -40,7 +44,36 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 	RetryLimitCount = 10;
 	RetryTimeoutRelativeSeconds = 5;
 
-	if (IsRunningOnZeuz())
+	PayloadStatePollMinInterval = 1.0f;
+	PayloadStatePollBackoffMultiplier = 2.0f;
+	PayloadStatePollMaxIntervalReady = 4.0f;
+	PayloadStatePollMaxIntervalReserved = 30.0f;
+	PayloadStatePollMaxIntervalTerminal = 10.0f;
+
+	SessionStatusCoalesceWindow = 0.25f;
+
+	ServerWarmupDeadline = 15.0f;
+
+	IdleNetServerMaxTickRate = 5;
+	PendingLoginTimeout = 30.0f;
+	bIsIdle = false;
+	ActiveNetServerMaxTickRate = 0;
+	TimeOfLastIdleModeChange = FPlatformTime::Seconds();
+	TotalIdleTime = 0.0;
+	TotalActiveTime = 0.0;
+	NumPendingLogins = 0;
+	TimeOfLastPreLogin = 0.0;
+
+	TelemetryWindowSeconds = 10.0f;
+	TelemetryLoadMidFrameTimeMs = 10.0f;
+	TelemetryLoadHighFrameTimeMs = 25.0f;
+
+	DrainDeadline = 10.0f;
+
+	CurrentPayloadState = IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unknown;
+	TimeOfLastPayloadStateChange = 0;
+
+	if (IsRunningOnZeuz() && !HasAnyFlags(RF_ClassDefaultObject))
 	{
 		SetupPayloadLocalAPI();
 	}
@@ -84,6 +117,13 @@ TSubclassOf<AGameSession> AShooterGameMode::GetGameSessionClass() const
 
 bool AShooterGameMode::IsRunningOnZeuz()
 {
+#if WITH_SHOOTER_PAYLOAD_MOCK
+	if (FShooterPayloadLocalApiMock::IsEnabled())
+	{
+		return true;
+	}
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
+
 	return FParse::Param(FCommandLine::Get(), TEXT("zeuz"));
 }
 
@@ -94,25 +134,29 @@ bool AShooterGameMode::WasCreatedBySessionManager()
 
 void AShooterGameMode::SetupPayloadLocalAPI()
 {
-	CurrentPayloadState = IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unknown;
-	TimeOfLastPayloadStateChange = 0;
-
 	RetryPolicy = IMSZeuzAPI::HttpRetryParams(RetryLimitCount, RetryTimeoutRelativeSeconds);
-	PayloadLocalAPI = MakeShared<IMSZeuzAPI::OpenAPIPayloadLocalApi>();
-	SessionManagerLocalAPI = MakeShared<IMSZeuzAPI::OpenAPISessionManagerLocalApi>();
+	IMSClient = MakeShared<FShooterIMSClient>();
 	
 	OnSetPayloadToReadyDelegate = IMSZeuzAPI::OpenAPIPayloadLocalApi::FReadyV0Delegate::CreateUObject(this, &AShooterGameMode::OnSetPayloadToReadyComplete);
-	OnUpdatePayloadStatusDelegate = IMSZeuzAPI::OpenAPIPayloadLocalApi::FGetPayloadV0Delegate::CreateUObject(this, &AShooterGameMode::OnUpdatePayloadStatusComplete);
 	OnRetrieveSessionConfigDelegate = IMSZeuzAPI::OpenAPISessionManagerLocalApi::FGetSessionConfigV0Delegate::CreateUObject(this, &AShooterGameMode::OnRetrieveSessionConfigComplete);
-	OnSetSessionStatusDelegate = IMSZeuzAPI::OpenAPISessionManagerLocalApi::FApiV0SessionManagerStatusPostDelegate::CreateUObject(this, &AShooterGameMode::OnSetSessionStatusComplete);
 
 	FString payloadApiDomain = FPlatformMisc::GetEnvironmentVariable(*FString("ORCHESTRATION_PAYLOAD_API"));
 
+#if WITH_SHOOTER_PAYLOAD_MOCK
+	if (FShooterPayloadLocalApiMock* PayloadLocalApiMock = FShooterPayloadLocalApiMock::Get())
+	{
+		// Started with -zeuz-mock, use the in-process stand-in instead of the real Payload Local API
+		FString payloadApiUrl = PayloadLocalApiMock->GetURL();
+		IMSClient->SetURL(payloadApiUrl);
+
+		UE_LOG(LogGameMode, Display, TEXT("Payload Local API URL was set to '%s' (mock)"), *payloadApiUrl);
+	}
+	else
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
 	if (!payloadApiDomain.IsEmpty())
 	{
 		FString payloadApiUrl = "http://" + payloadApiDomain;
-		PayloadLocalAPI->SetURL(payloadApiUrl);
-		SessionManagerLocalAPI->SetURL(payloadApiUrl);
+		IMSClient->SetURL(payloadApiUrl);
 
 		UE_LOG(LogGameMode, Display, TEXT("Payload Local API URL was set to '%s'"), *payloadApiUrl);
 	}
@@ -120,6 +164,21 @@ void AShooterGameMode::SetupPayloadLocalAPI()
 	{
 		UE_LOG(LogGameMode, Error, TEXT("No environment variable with key 'ORCHESTRATION_PAYLOAD_API' was found."));
 	}
+
+	// Creating, Starting and Unknown are always polled at the min interval
+	FShooterPayloadPollSchedule PollSchedule;
+	PollSchedule.MinInterval = PayloadStatePollMinInterval;
+	PollSchedule.BackoffMultiplier = PayloadStatePollBackoffMultiplier;
+	PollSchedule.MaxIntervals.Add(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Ready, PayloadStatePollMaxIntervalReady);
+	PollSchedule.MaxIntervals.Add(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Reserved, PayloadStatePollMaxIntervalReserved);
+	PollSchedule.MaxIntervals.Add(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Shutdown, PayloadStatePollMaxIntervalTerminal);
+	PollSchedule.MaxIntervals.Add(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Error, PayloadStatePollMaxIntervalTerminal);
+	PollSchedule.MaxIntervals.Add(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unhealthy, PayloadStatePollMaxIntervalTerminal);
+
+	PayloadStateWatcher = MakeShared<FShooterPayloadStateWatcher>(IMSClient.ToSharedRef(), PollSchedule);
+	PayloadStateWatcher->OnStateChanged().AddUObject(this, &AShooterGameMode::OnPayloadStateChanged);
+
+	SessionStatusPublisher = MakeShared<FShooterSessionStatusPublisher>(IMSClient.ToSharedRef(), SessionStatusCoalesceWindow, RetryPolicy);
 }
 
 void AShooterGameMode::PreInitializeComponents()
@@ -127,6 +186,26 @@ void AShooterGameMode::PreInitializeComponents()
 	Super::PreInitializeComponents();
 
 	GetWorldTimerManager().SetTimer(TimerHandle_DefaultTimer, this, &AShooterGameMode::DefaultTimer, GetWorldSettings()->GetEffectiveTimeDilation(), true);
+
+	if (IMSClient.IsValid())
+	{
+		FShooterServerTelemetrySettings TelemetrySettings;
+		TelemetrySettings.WindowSeconds = TelemetryWindowSeconds;
+		TelemetrySettings.LoadMidFrameTimeMs = TelemetryLoadMidFrameTimeMs;
+		TelemetrySettings.LoadHighFrameTimeMs = TelemetryLoadHighFrameTimeMs;
+
+		ServerTelemetry = MakeShared<FShooterServerTelemetry>(IMSClient.ToSharedRef(), GetWorld(), TelemetrySettings);
+	}
+}
+
+void AShooterGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IMSClient.IsValid())
+	{
+		IMSClient->CancelAllRequests();
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AShooterGameMode::DefaultTimer()
@@ -142,7 +221,7 @@ void AShooterGameMode::DefaultTimer()
 		return;
 	}
 
-	UpdatePayloadStatus();
+	UpdateIdleMode();
 
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	if (MyGameState && MyGameState->RemainingTime > 0 && !MyGameState->bTimerPaused)
@@ -154,7 +233,7 @@ void AShooterGameMode::DefaultTimer()
 				if (UGameplayStatics::GetRealTimeSeconds(GetWorld()) - TimeOfLastPayloadStateChange > TimeBeforeReservedPayloadTimeout)
 				{
 					// Shutdown server to avoid filling allocation buffer with reserved payloads that are not being used
-					FGenericPlatformMisc::RequestExit(false);
+					BeginDrain(NSLOCTEXT("GameMessages", "ReservedTimeout", "The server was not joined in time."));
 				}
 			}
 			
@@ -167,7 +246,7 @@ void AShooterGameMode::DefaultTimer()
 		{
 			if (GetMatchState() == MatchState::WaitingPostMatch)
 			{
-				ExitPlayersToMainMenu();
+				BeginDrain(NSLOCTEXT("GameMessages", "MatchEnded", "The match has ended."));
 			}
 			else if (GetMatchState() == MatchState::InProgress)
 			{
@@ -196,10 +275,104 @@ void AShooterGameMode::DefaultTimer()
 	// if the match is over and all clients have been disconnected, exit the server
 	else if (GetMatchState() == MatchState::WaitingPostMatch && GetNumPlayers() == 0)
 	{
-		FGenericPlatformMisc::RequestExit(false);
+		BeginDrain(NSLOCTEXT("GameMessages", "MatchEnded", "The match has ended."));
 	}
 }
 
+bool AShooterGameMode::ShouldBeIdle() const
+{
+	return GetNumPlayers() == 0
+		&& NumPendingLogins == 0
+		&& (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Ready || CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Reserved);
+}
+
+void AShooterGameMode::UpdateIdleMode()
+{
+	// A client that drops between PreLogin and Login never reaches PostLogin, don't let it keep the server awake forever
+	if (NumPendingLogins > 0 && FPlatformTime::Seconds() - TimeOfLastPreLogin > PendingLoginTimeout)
+	{
+		UE_LOG(LogGameMode, Log, TEXT("Releasing %d pending login(s) that did not complete within %.0fs"), NumPendingLogins, PendingLoginTimeout);
+		NumPendingLogins = 0;
+	}
+
+	const bool bShouldBeIdle = ShouldBeIdle();
+	if (bShouldBeIdle != bIsIdle)
+	{
+		SetIdleMode(bShouldBeIdle);
+	}
+}
+
+void AShooterGameMode::SetIdleMode(bool bNewIdle)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (bIsIdle)
+	{
+		TotalIdleTime += Now - TimeOfLastIdleModeChange;
+	}
+	else
+	{
+		TotalActiveTime += Now - TimeOfLastIdleModeChange;
+	}
+	TimeOfLastIdleModeChange = Now;
+	bIsIdle = bNewIdle;
+
+	// The dedicated server frame rate is capped by the net driver tick rate
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver)
+	{
+		if (bIsIdle)
+		{
+			ActiveNetServerMaxTickRate = NetDriver->NetServerMaxTickRate;
+			NetDriver->NetServerMaxTickRate = FMath::Min(IdleNetServerMaxTickRate, ActiveNetServerMaxTickRate);
+		}
+		else if (ActiveNetServerMaxTickRate > 0)
+		{
+			NetDriver->NetServerMaxTickRate = ActiveNetServerMaxTickRate;
+		}
+	}
+
+	for (AShooterAIController* BotController : BotControllers)
+	{
+		UBrainComponent* BrainComponent = BotController ? BotController->GetBrainComponent() : nullptr;
+		if (BrainComponent)
+		{
+			if (bIsIdle)
+			{
+				BrainComponent->PauseLogic(TEXT("Server idle"));
+			}
+			else
+			{
+				BrainComponent->ResumeLogic(TEXT("Server idle"));
+			}
+		}
+	}
+
+	for (AShooterPickup* Pickup : LevelPickups)
+	{
+		if (Pickup)
+		{
+			Pickup->SetRespawnTimerPaused(bIsIdle);
+		}
+	}
+
+	UE_LOG(LogGameMode, Display, TEXT("Server is now %s (idle for %.0fs, active for %.0fs so far)"), bIsIdle ? TEXT("idle") : TEXT("active"), TotalIdleTime, TotalActiveTime);
+}
+
+double AShooterGameMode::GetIdleTime() const
+{
+	return TotalIdleTime + (bIsIdle ? FPlatformTime::Seconds() - TimeOfLastIdleModeChange : 0.0);
+}
+
+double AShooterGameMode::GetActiveTime() const
+{
+	return TotalActiveTime + (bIsIdle ? 0.0 : FPlatformTime::Seconds() - TimeOfLastIdleModeChange);
+}
+
+void AShooterGameMode::DumpIdleStats()
+{
+	UE_LOG(LogGameMode, Display, TEXT("DumpIdleStats: bIsIdle = %s, IdleTime = %.1fs, ActiveTime = %.1fs"), bIsIdle ? TEXT("true") : TEXT("false"), GetIdleTime(), GetActiveTime());
+}
+
 void AShooterGameMode::HandleMatchIsWaitingToStart()
 {
 	Super::HandleMatchIsWaitingToStart();
@@ -228,55 +401,80 @@ void AShooterGameMode::HandleMatchIsWaitingToStart()
 		}
 	}
 
-	if (IsRunningOnZeuz() && PayloadLocalAPI != NULL)
+	if (IsRunningOnZeuz() && IMSClient.IsValid())
 	{
-		TrySetPayloadToReady();
+		StartServerWarmup();
 	}
 }
 
-void AShooterGameMode::TrySetPayloadToReady()
+void AShooterGameMode::StartServerWarmup()
 {
-	IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Request Request;
-	Request.SetShouldRetry(RetryPolicy);
+	StartupTimeline.Mark(TEXT("map loaded"));
 
-	UE_LOG(LogGameMode, Display, TEXT("Attempting to set payload to Ready state..."));
-	PayloadLocalAPI->ReadyV0(Request, OnSetPayloadToReadyDelegate);
+	// Load what the first players and bots would otherwise load on first use, while the navigation finishes building
+	ServerWarmup = MakeShared<FShooterServerWarmup>(GetWorld(), ServerWarmupDeadline);
+	ServerWarmup->AddClassDependencies(DefaultPawnClass);
+	ServerWarmup->AddClassDependencies(BotPawnClass);
 
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	TWeakObjectPtr<AShooterGameMode> WeakThis(this);
+	ServerWarmup->Start([WeakThis](bool bTimedOut)
+	{
+		if (AShooterGameMode* GameMode = WeakThis.Get())
+		{
+			GameMode->StartupTimeline.Mark(bTimedOut ? TEXT("warm (deadline)") : TEXT("warm"));
+			GameMode->TrySetPayloadToReady();
+		}
+	});
 }
 
-void AShooterGameMode::UpdatePayloadStatus()
+void AShooterGameMode::TrySetPayloadToReady()
 {
-	IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Request Request;
-	Request.SetShouldRetry(RetryPolicy);
+	if (!IMSClient.IsValid())
+	{
+		return;
+	}
 
-	PayloadLocalAPI->GetPayloadV0(Request, OnUpdatePayloadStatusDelegate);
+	IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Request Request;
+	Request.SetShouldRetry(RetryPolicy);
 
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	UE_LOG(LogGameMode, Display, TEXT("Attempting to set payload to Ready state..."));
+	IMSClient->ReadyV0(Request, OnSetPayloadToReadyDelegate);
 }
 
 void AShooterGameMode::RetrieveSessionConfig()
 {
+	if (!IMSClient.IsValid())
+	{
+		return;
+	}
+
 	IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0Request Request;
 	Request.SetShouldRetry(RetryPolicy);
 
 	UE_LOG(LogGameMode, Display, TEXT("Attempting to retrieve session config..."));
-	SessionManagerLocalAPI->GetSessionConfigV0(Request, OnRetrieveSessionConfigDelegate);
-
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	IMSClient->GetSessionConfigV0(Request, OnRetrieveSessionConfigDelegate);
 }
 
 void AShooterGameMode::SetSessionStatus()
 {
-	IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest Request;
-	Request.SetShouldRetry(RetryPolicy);
+	if (!SessionStatusPublisher.IsValid())
+	{
+		return;
+	}
 
-	Request.RequestBody = CreateSessionStatusBody();
+	SessionStatusPublisher->SetFields(CreateSessionStatusBody());
+}
 
-	UE_LOG(LogGameMode, Display, TEXT("Attempting to set session status..."));
-	SessionManagerLocalAPI->ApiV0SessionManagerStatusPost(Request, OnSetSessionStatusDelegate);
+void AShooterGameMode::DumpSessionStatusStats()
+{
+	if (!SessionStatusPublisher.IsValid())
+	{
+		UE_LOG(LogGameMode, Display, TEXT("DumpSessionStatusStats: session status is not published when not running on IMS zeuz"));
+		return;
+	}
 
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	const FShooterSessionStatusPublisherStats& Stats = SessionStatusPublisher->GetStats();
+	UE_LOG(LogGameMode, Display, TEXT("DumpSessionStatusStats: Sent = %u, Skipped = %u, Merged = %u, Failed = %u"), Stats.Sent, Stats.Skipped, Stats.Merged, Stats.Failed);
 }
 
 void AShooterGameMode::OnSetPayloadToReadyComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Response& Response)
@@ -284,40 +482,40 @@ void AShooterGameMode::OnSetPayloadToReadyComplete(const IMSZeuzAPI::OpenAPIPayl
 	if (Response.IsSuccessful())
 	{
 		UE_LOG(LogGameMode, Display, TEXT("Successfully set Payload to Ready state."));
+
+		StartupTimeline.Mark(TEXT("Ready acknowledged"));
+		StartupTimeline.Log();
 	}
 	else
 	{
 		UE_LOG(LogGameMode, Display, TEXT("Failed to set Payload to Ready state."));
-		FGenericPlatformMisc::RequestExit(false); // Shutdown server
+		BeginDrain(NSLOCTEXT("GameMessages", "ServerUnavailable", "The server is unavailable.")); // Shutdown server
 	}
 }
 
-void AShooterGameMode::OnUpdatePayloadStatusComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Response& Response)
+void AShooterGameMode::OnPayloadStateChanged(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values OldState, IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState)
 {
-	if (Response.IsSuccessful())
-	{
-		IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values PendingState = Response.Content.Result.Status.State.Value;
-		if (CurrentPayloadState != PendingState)
-		{
-			CurrentPayloadState = PendingState;
-			TimeOfLastPayloadStateChange = UGameplayStatics::GetRealTimeSeconds(GetWorld());
+	CurrentPayloadState = NewState;
+	TimeOfLastPayloadStateChange = UGameplayStatics::GetRealTimeSeconds(GetWorld());
 
-			if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Reserved && WasCreatedBySessionManager())
-			{
-				UE_LOG(LogGameMode, Display, TEXT("Updated payload status to reserved."));
+	if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Reserved && WasCreatedBySessionManager())
+	{
+		UE_LOG(LogGameMode, Display, TEXT("Updated payload status to reserved."));
 
-				RetrieveSessionConfig();
-			}
-			else if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Error || CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unhealthy)
-			{
-				UE_LOG(LogGameMode, Error, TEXT("Payload status is error/unhealthy"));
-				// Handle appropriately
-			}
-		}
+		RetrieveSessionConfig();
 	}
-	else
+	else if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Shutdown)
 	{
-		UE_LOG(LogGameMode, Display, TEXT("Failed to retrieve payload details."));
+		UE_LOG(LogGameMode, Display, TEXT("Payload status is shutdown"));
+		BeginDrain(NSLOCTEXT("GameMessages", "ServerShutdown", "The server is shutting down."));
+	}
+	else if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Error || CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unhealthy)
+	{
+		UE_LOG(LogGameMode, Error, TEXT("Payload status is error/unhealthy"));
+		if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unhealthy)
+		{
+			BeginDrain(NSLOCTEXT("GameMessages", "ServerUnhealthy", "The server is no longer available."));
+		}
 	}
 }
 
@@ -343,49 +541,63 @@ void AShooterGameMode::OnRetrieveSessionConfigComplete(const IMSZeuzAPI::OpenAPI
 	}
 }
 
-void AShooterGameMode::OnSetSessionStatusComplete(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse& Response)
+void AShooterGameMode::ProcessSessionConfig(const FString& SessionConfigJson)
 {
-	if (Response.IsSuccessful())
+	UE_LOG(LogGameMode, Display, TEXT("Processing SessionConfig: %s"), *SessionConfigJson);
+
+	FShooterSessionConfig SessionConfig;
+	TArray<FString> UnknownKeys;
+	FString Error;
+
+	if (!SessionConfig.Decode(SessionConfigJson, &UnknownKeys, &Error))
 	{
-		UE_LOG(LogGameMode, Display, TEXT("Successfully set session status."));
+		// The deserialization failed, handle this case
+		UE_LOG(LogGameMode, Display, TEXT("Failed to deserialize Json from Session Config: %s"), *Error);
+		return;
 	}
-	else
+
+	if (UnknownKeys.Num() > 0)
 	{
-		UE_LOG(LogGameMode, Display, TEXT("Failed to set session status."));
+		UE_LOG(LogGameMode, Warning, TEXT("Ignoring unknown Session Config keys: %s"), *FString::Join(UnknownKeys, TEXT(", ")));
 	}
-}
 
-void AShooterGameMode::ProcessSessionConfig(FString SessionConfig)
-{
-	UE_LOG(LogGameMode, Display, TEXT("Processing SessionConfig: %s"), *SessionConfig);
-
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SessionConfig);
+	if (SessionConfig.MaxNumPlayers.IsSet())
+	{
+		MaxNumPlayers = SessionConfig.MaxNumPlayers.GetValue();
+	}
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (SessionConfig.RoundTime.IsSet())
 	{
-		// The deserialization failed, handle this case
-		UE_LOG(LogGameMode, Display, TEXT("Failed to deserialize Json from Session Config."));
+		RoundTime = SessionConfig.RoundTime.GetValue();
 	}
-	else
+
+	if (SessionConfig.WarmupTime.IsSet())
 	{
-		int32 MaxNumPlayersFromJson;
-		int32 BotsCountFromJson;
+		WarmupTime = SessionConfig.WarmupTime.GetValue();
 
-		if (JsonObject->TryGetNumberField("MaxNumPlayers", MaxNumPlayersFromJson))
+		// HandleMatchIsWaitingToStart has already started the warmup countdown with the previous value
+		AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
+		if (MyGameState && GetMatchState() == MatchState::WaitingToStart && !GetWorld()->IsPlayInEditor())
 		{
-			MaxNumPlayers = FMath::Clamp(MaxNumPlayersFromJson, MIN_NUMBER_PLAYERS, MAX_NUMBER_PLAYERS);
+			MyGameState->RemainingTime = FMath::Max(WarmupTime, 0);
 		}
+	}
 
-		if (JsonObject->TryGetNumberField("BotsCount", BotsCountFromJson))
-		{
-			SetAllowBots(BotsCountFromJson > 0 ? true : false, BotsCountFromJson);
-			CreateBotControllers();
-			bNeedsBotCreation = false;
-		}
+	// The map and game mode are chosen by the session type when the payload is started, only report a mismatch
+	if (SessionConfig.MapName.IsSet() && SessionConfig.MapName.GetValue() != GetWorld()->GetMapName())
+	{
+		UE_LOG(LogGameMode, Warning, TEXT("Session Config requests map %s but the server is running %s"), *SessionConfig.MapName.GetValue(), *GetWorld()->GetMapName());
+	}
 
-		SetSessionStatus();
+	if (SessionConfig.BotsCount.IsSet())
+	{
+		const int32 BotsCount = SessionConfig.BotsCount.GetValue();
+		SetAllowBots(BotsCount > 0 ? true : false, BotsCount);
+		CreateBotControllers();
+		bNeedsBotCreation = false;
 	}
+
+	SetSessionStatus();
 }
 
 TMap<FString, FString> AShooterGameMode::CreateSessionStatusBody()
@@ -400,18 +612,70 @@ TMap<FString, FString> AShooterGameMode::CreateSessionStatusBody()
 	return Body;
 }
 
-void AShooterGameMode::ExitPlayersToMainMenu()
+void AShooterGameMode::ExitPlayersToMainMenu(const FText& Reason)
 {
 	// send the players back to the main menu
 	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
 	{
-		(*It)->ClientReturnToMainMenuWithTextReason(NSLOCTEXT("GameMessages", "MatchEnded", "The match has ended."));
+		(*It)->ClientReturnToMainMenuWithTextReason(Reason);
 
 		AShooterPlayerController* ShooterPlayerController = Cast<AShooterPlayerController>(*It);
-		ShooterPlayerController->HandleReturnToMainMenu();
+		if (ShooterPlayerController)
+		{
+			ShooterPlayerController->HandleReturnToMainMenu();
+		}
 	}
 }
 
+void AShooterGameMode::BeginDrain(const FText& Reason)
+{
+	if (IsDraining())
+	{
+		return;
+	}
+
+	// Players are no longer admitted from now on, see PreLogin
+	ServerDrain = MakeShared<FShooterServerDrain>(Reason, DrainDeadline);
+
+	ServerDrain->AddStep(TEXT("Notify players"),
+		[this, Reason]() { ExitPlayersToMainMenu(Reason); },
+		[this]() { return GetNumPlayers() == 0; });
+
+	ServerDrain->AddStep(TEXT("Finish replay"),
+		[this]()
+		{
+			UGameInstance* GameInstance = GetGameInstance();
+			if (GameInstance && GetWorld()->IsRecordingReplay())
+			{
+				GameInstance->StopRecordingReplay();
+			}
+		},
+		[this]() { return !GetWorld()->IsRecordingReplay(); });
+
+	if (SessionStatusPublisher.IsValid())
+	{
+		ServerDrain->AddStep(TEXT("Flush session status"),
+			[this]()
+			{
+				SetSessionStatus();
+				SessionStatusPublisher->Flush();
+			},
+			[this]() { return SessionStatusPublisher->IsFlushed(); });
+	}
+
+	if (ServerTelemetry.IsValid())
+	{
+		ServerDrain->AddStep(TEXT("Flush telemetry"),
+			[this]() { ServerTelemetry->Flush(); },
+			[this]() { return ServerTelemetry->IsFlushed(); });
+	}
+
+	ServerDrain->Start([](bool bTimedOut)
+	{
+		FGenericPlatformMisc::RequestExit(false);
+	});
+}
+
 void AShooterGameMode::HandleMatchHasStarted()
 {
 	bNeedsBotCreation = true;
@@ -533,6 +797,10 @@ void AShooterGameMode::PreLogin(const FString& Options, const FString& Address,
 	{
 		ErrorMessage = TEXT("Player capacity is full!");
 	}
+	else if (IsDraining())
+	{
+		ErrorMessage = ServerDrain->GetReason().ToString();
+	}
 	else if (CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Shutdown
 		|| CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unhealthy
 		|| CurrentPayloadState == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Error)
@@ -544,6 +812,33 @@ void AShooterGameMode::PreLogin(const FString& Options, const FString& Address,
 		// GameSession can be NULL if the match is over
 		Super::PreLogin(Options, Address, UniqueId, ErrorMessage);
 	}
+
+	if (ErrorMessage.IsEmpty())
+	{
+		// The player is not counted by GetNumPlayers until PostLogin, hold the server out of idle mode until then
+		++NumPendingLogins;
+		TimeOfLastPreLogin = FPlatformTime::Seconds();
+
+		// Restore the full tick rate right away so the connecting player is not handled at the idle rate
+		UpdateIdleMode();
+	}
+}
+
+APlayerController* AShooterGameMode::Login(UPlayer* NewPlayer, ENetRole InRemoteRole, const FString& Portal, const FString& Options, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage)
+{
+	APlayerController* const NewPlayerController = Super::Login(NewPlayer, InRemoteRole, Portal, Options, UniqueId, ErrorMessage);
+	if (NewPlayerController == nullptr || !ErrorMessage.IsEmpty())
+	{
+		ReleasePendingLogin();
+		UpdateIdleMode();
+	}
+
+	return NewPlayerController;
+}
+
+void AShooterGameMode::ReleasePendingLogin()
+{
+	NumPendingLogins = FMath::Max(NumPendingLogins - 1, 0);
 }
 
 
@@ -551,6 +846,10 @@ void AShooterGameMode::PostLogin(APlayerController* NewPlayer)
 {
 	Super::PostLogin(NewPlayer);
 
+	// The player is now counted by GetNumPlayers
+	ReleasePendingLogin();
+	UpdateIdleMode();
+
 	// update spectator location for client
 	AShooterPlayerController* NewPC = Cast<AShooterPlayerController>(NewPlayer);
 	if (NewPC && NewPC->GetPawn() == NULL)
@@ -567,6 +866,12 @@ void AShooterGameMode::PostLogin(APlayerController* NewPlayer)
 
 	// Update Session Status so that player count reflects that a new player has joined
 	SetSessionStatus();
+
+	// A player joining usually comes with a payload state change
+	if (PayloadStateWatcher.IsValid())
+	{
+		PayloadStateWatcher->PollNow();
+	}
 }
 
 void AShooterGameMode::Logout(AController* Exiting)
@@ -575,6 +880,14 @@ void AShooterGameMode::Logout(AController* Exiting)
 
 	// Update Session Status so that player count reflects that a player has left the game
 	SetSessionStatus();
+
+	// Go back to idle right away if that was the last player
+	UpdateIdleMode();
+
+	if (PayloadStateWatcher.IsValid())
+	{
+		PayloadStateWatcher->PollNow();
+	}
 }
 
 void AShooterGameMode::SetMatchState(FName NewState)
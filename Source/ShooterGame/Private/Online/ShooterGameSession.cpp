@@ -3,6 +3,8 @@
 #include "ShooterGame.h"
 #include "ShooterGameSession.h"
 #include "ShooterOnlineGameSettings.h"
+#include "Online/ShooterSessionConfig.h"
+#include "Online/ShooterQosProber.h"
 #include "OnlineSubsystemSessionSettings.h"
 #include "OnlineSubsystemUtils.h"
 
@@ -17,10 +19,13 @@ AShooterGameSession::AShooterGameSession(const FObjectInitializer& ObjectInitial
 	if (!HasAnyFlags(RF_ClassDefaultObject))
 	{
 		OnCreateSessionCompleteDelegate = IMSSessionManagerAPI::OpenAPISessionManagerV0Api::FCreateSessionV0Delegate::CreateUObject(this, &AShooterGameSession::OnCreateSessionComplete);
-		OnFindSessionsCompleteDelegate = IMSSessionManagerAPI::OpenAPISessionManagerV0Api::FListSessionsV0Delegate::CreateUObject(this, &AShooterGameSession::OnFindSessionsComplete);
 
 		RetryPolicy = IMSSessionManagerAPI::HttpRetryParams(RetryLimitCount, RetryTimeoutRelativeSeconds);
 		SessionManagerAPI = MakeShared<IMSSessionManagerAPI::OpenAPISessionManagerV0Api>();
+
+		// The session searches repeat, their results are copied out of the responses
+		SessionManagerAPI->SetResponsePooling(true);
+
 		CurrentSessionSearch = MakeShared<class SessionSearch>();
 	}
 }
@@ -47,11 +52,43 @@ FString AShooterGameSession::GetIMSSessionType()
 	return IMSSessionType;
 }
 
+TArray<FString> AShooterGameSession::GetIMSSearchSessionTypes()
+{
+	TArray<FString> SessionTypes;
+	FString SessionTypesList;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SearchSessionTypes="), SessionTypesList, false))
+	{
+		SessionTypesList.ParseIntoArray(SessionTypes, TEXT(","));
+	}
+	else
+	{
+		SessionTypes = IMSSearchSessionTypes;
+	}
+
+	TArray<FString> UniqueSessionTypes;
+	for (const FString& SessionType : SessionTypes)
+	{
+		const FString TrimmedSessionType = SessionType.TrimStartAndEnd();
+		if (!TrimmedSessionType.IsEmpty())
+		{
+			UniqueSessionTypes.AddUnique(TrimmedSessionType);
+		}
+	}
+
+	if (UniqueSessionTypes.Num() == 0)
+	{
+		UniqueSessionTypes.Add(GetIMSSessionType());
+	}
+	return UniqueSessionTypes;
+}
+
 /**
  * Delegate fired when a session create request has completed
  */
 void AShooterGameSession::OnCreateSessionComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::CreateSessionV0Response& Response)
 {
+	FString SessionAddress;
+
 	if (Response.IsSuccessful() && Response.Content.Address.IsSet() && Response.Content.Ports.IsSet())
 	{
 		FString IP = Response.Content.Address.GetValue();
@@ -60,21 +97,28 @@ void AShooterGameSession::OnCreateSessionComplete(const IMSSessionManagerAPI::Op
 
 		if (GamePortResponse != nullptr)
 		{
-			FString SessionAddress = IP + ":" + FString::FromInt(GamePortResponse->Port);
+			SessionAddress = IP + ":" + FString::FromInt(GamePortResponse->Port);
 
 			UE_LOG(LogOnlineGame, Display, TEXT("Successfully created a session. Connect to session address: '%s'"), *SessionAddress);
-			OnCreateSessionComplete().Broadcast(SessionAddress, true);
 		}
 		else
 		{
 			UE_LOG(LogOnlineGame, Error, TEXT("Successfully created a session but could not find the Game Port."));
-			OnCreateSessionComplete().Broadcast("", false);
 		}
 	}
 	else
 	{
 		UE_LOG(LogOnlineGame, Display, TEXT("Failed to create a session."));
-		OnCreateSessionComplete().Broadcast("", false);
+	}
+
+	if (bQuickJoinInProgress)
+	{
+		// The session created by a quick join is travelled to right away, as the game instance does for hosted games
+		FinishQuickJoin(!SessionAddress.IsEmpty() && TravelToSession(SessionAddress));
+	}
+	else
+	{
+		OnCreateSessionComplete().Broadcast(SessionAddress, !SessionAddress.IsEmpty());
 	}
 }
 
@@ -92,53 +136,294 @@ void AShooterGameSession::HostSession(const int32 MaxNumPlayers, const int32 Bot
 	RequestBody.SessionConfig = CreateSessionConfigJson(MaxNumPlayers, BotsCount);
 	Request.Body = RequestBody;
 
+	// A new session supersedes the one being created, which stops retrying once the retry policy would have given up
+	HostSessionToken = IMSOpenAPI::MakeCancellationToken();
+	Request.SetCancellationToken(HostSessionToken.ToSharedRef());
+	Request.SetDeadline(FPlatformTime::Seconds() + RetryTimeoutRelativeSeconds);
+
 	UE_LOG(LogOnlineGame, Display, TEXT("Attempting to create a session..."));
 	SessionManagerAPI->CreateSessionV0(Request, OnCreateSessionCompleteDelegate);
 
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	// Flushing blocks until the request completes, past the time budget of a quick join
+	if (!bQuickJoinInProgress)
+	{
+		FHttpModule::Get().GetHttpManager().Flush(false);
+	}
+}
+
+void AShooterGameSession::OnFindSessionsComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Response& Response, uint32 Serial, int32 PoolIndex)
+{
+	if (Serial != SearchSerial || !SearchPools.IsValidIndex(PoolIndex) || !SearchPools[PoolIndex].bPending)
+	{
+		return;
+	}
+
+	FShooterSessionSearchPool& Pool = SearchPools[PoolIndex];
+	if (!Response.IsSuccessful())
+	{
+		UE_LOG(LogOnlineGame, Display, TEXT("Failed to list sessions of type '%s'."), *Pool.SessionType);
+		Pool.bPending = false;
+		OnSearchPoolComplete();
+		return;
+	}
+
+	UE_LOG(LogOnlineGame, Display, TEXT("Successfully listed sessions of type '%s'."), *Pool.SessionType);
+	++NumListedPools;
+
+	// Every session is probed and ranked before the results are cut down to MaxSearchResults, a session listed by
+	// several types is only kept once
+	for (const IMSSessionManagerAPI::OpenAPIV0Session& SessionResult : Response.Content.Sessions)
+	{
+		if (ListedSessionIds.Num() >= CurrentSessionSearch->MaxProbedSessions)
+		{
+			break;
+		}
+
+		bool bAlreadyListed = false;
+		ListedSessionIds.Add(SessionResult.Id, &bAlreadyListed);
+		if (!bAlreadyListed)
+		{
+			Pool.Results.Emplace(SessionResult);
+		}
+	}
+
+	if (Pool.Results.Num() == 0)
+	{
+		Pool.bPending = false;
+		OnSearchPoolComplete();
+		return;
+	}
+
+	Pool.QosProber = MakeUnique<FShooterQosProber>();
+	for (const FSessionRecord& Result : Pool.Results)
+	{
+		Pool.QosProber->AddTarget(Result.Address, Result.QosPort);
+	}
+
+	// The session type stays pending while its sessions are probed
+	TWeakObjectPtr<AShooterGameSession> WeakThis(this);
+	Pool.QosProber->Start([WeakThis, Serial, PoolIndex](const TArray<FShooterQosResult>& Results)
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->OnQosProbesComplete(Results, Serial, PoolIndex);
+		}
+	});
 }
 
-void AShooterGameSession::OnFindSessionsComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Response& Response)
+void AShooterGameSession::OnQosProbesComplete(const TArray<FShooterQosResult>& Results, uint32 Serial, int32 PoolIndex)
 {
-	if (Response.IsSuccessful())
+	if (Serial != SearchSerial || !SearchPools.IsValidIndex(PoolIndex) || !SearchPools[PoolIndex].bPending)
+	{
+		return;
+	}
+
+	FShooterSessionSearchPool& Pool = SearchPools[PoolIndex];
+	for (int32 Index = 0; Index < Pool.Results.Num() && Index < Results.Num(); ++Index)
 	{
-		UE_LOG(LogOnlineGame, Display, TEXT("Successfully listed sessions."));
+		Pool.Results[Index].Qos = Results[Index];
+	}
 
-		TArray<Session> SearchResults;
+	CurrentSessionSearch->PendingResults.Append(MoveTemp(Pool.Results));
+	Pool.Results.Reset();
+	Pool.bPending = false;
 
-		for (IMSSessionManagerAPI::OpenAPIV0Session SessionResult : Response.Content.Sessions)
+	OnSearchPoolComplete();
+}
+
+void AShooterGameSession::OnSearchPoolComplete()
+{
+	const bool bPoolsPending = SearchPools.ContainsByPredicate([](const FShooterSessionSearchPool& Pool) { return Pool.bPending; });
+	if (!bPoolsPending)
+	{
+		CompleteFindSessions();
+		return;
+	}
+
+	// The sessions found so far are shown while the slower session types answer, background refreshes keep the
+	// results of the previous search instead, which still hold the sessions of the other types
+	if (!bBackgroundSearch && CurrentSessionSearch->PendingResults.Num() > 0)
+	{
+		CurrentSessionSearch->PublishRankedResults();
+	}
+}
+
+void AShooterGameSession::OnFindSessionsTimeout()
+{
+	UE_LOG(LogOnlineGame, Warning, TEXT("Session search: not every session type answered within %d seconds"), RetryTimeoutRelativeSeconds);
+
+	if (FindSessionsToken.IsValid())
+	{
+		FindSessionsToken->Cancel();
+	}
+
+	// Sessions still being probed are kept, unmeasured, they are ranked after the ones that answered
+	for (FShooterSessionSearchPool& Pool : SearchPools)
+	{
+		if (Pool.bPending)
 		{
-			if (SearchResults.Num() < CurrentSessionSearch->MaxSearchResults)
+			if (Pool.QosProber.IsValid())
 			{
-				SearchResults.Add(Session(SessionResult));
+				Pool.QosProber->Cancel();
 			}
+			CurrentSessionSearch->PendingResults.Append(MoveTemp(Pool.Results));
+			Pool.Results.Reset();
+			Pool.bPending = false;
 		}
+	}
+
+	CompleteFindSessions();
+}
 
-		CurrentSessionSearch->SearchResults = SearchResults;
-		CurrentSessionSearch->SearchState = SearchState::Done;
+void AShooterGameSession::CompleteFindSessions()
+{
+	GetWorldTimerManager().ClearTimer(FindSessionsTimerHandle);
 
-		OnFindSessionsComplete().Broadcast(true);
-	}
-	else
+	UE_LOG(LogOnlineGame, Display, TEXT("Session search: %d sessions listed by %d of %d session types in %.0f ms"),
+		CurrentSessionSearch->PendingResults.Num(), NumListedPools, SearchPools.Num(), (FPlatformTime::Seconds() - FindSessionsStartTime) * 1000.0);
+
+	if (NumListedPools == 0)
 	{
 		UE_LOG(LogOnlineGame, Display, TEXT("Failed to list sessions."));
+		CurrentSessionSearch->PendingResults.Reset();
 		CurrentSessionSearch->SearchState = SearchState::Failed;
 		OnFindSessionsComplete().Broadcast(false);
+
+		if (bQuickJoinInProgress)
+		{
+			ContinueQuickJoin(FString());
+		}
+		return;
+	}
+
+	// A quick join picks from all the sessions probed, before they are cut down to MaxSearchResults
+	FString QuickJoinSessionAddress;
+	if (bQuickJoinInProgress)
+	{
+		const FSessionRecord* QuickJoinSession = CurrentSessionSearch->FindQuickJoinSession(CurrentSessionSearch->PendingResults, QuickJoinSettings.PreferredMapName);
+		if (QuickJoinSession != nullptr)
+		{
+			QuickJoinSessionAddress = QuickJoinSession->GetSessionAddress();
+		}
+	}
+
+	CurrentSessionSearch->CompleteWithRankedResults();
+
+	for (const FSessionRecord& Result : CurrentSessionSearch->SearchResults)
+	{
+		UE_LOG(LogOnlineGame, Log, TEXT("Session %s: latency %s, players %s, phase %s"), *Result.GetSessionAddress(), *Result.GetLatency(), *Result.GetPlayerCount(), *Result.GetGamePhase());
+	}
+
+	CurrentSessionSearch->SearchState = SearchState::Done;
+	OnFindSessionsComplete().Broadcast(true);
+
+	if (bQuickJoinInProgress)
+	{
+		ContinueQuickJoin(QuickJoinSessionAddress);
 	}
 }
 
+void AShooterGameSession::CancelFindSessions()
+{
+	++SearchSerial;
+	GetWorldTimerManager().ClearTimer(FindSessionsTimerHandle);
+
+	if (FindSessionsToken.IsValid())
+	{
+		FindSessionsToken->Cancel();
+	}
+
+	SearchPools.Reset();
+	ListedSessionIds.Reset();
+	NumListedPools = 0;
+	CurrentSessionSearch->PendingResults.Reset();
+}
+
+void AShooterGameSession::QuickJoin(FString SessionTicket, const FShooterQuickJoinSettings& Settings)
+{
+	CancelQuickJoin();
+
+	bQuickJoinInProgress = true;
+	QuickJoinSettings = Settings;
+	QuickJoinSessionTicket = SessionTicket;
+	GetWorldTimerManager().SetTimer(QuickJoinTimerHandle, this, &AShooterGameSession::OnQuickJoinTimeout, FMath::Max(Settings.BudgetSeconds, 1.0f), false);
+
+	UE_LOG(LogOnlineGame, Display, TEXT("Quick join: looking for a session within %.0f seconds..."), Settings.BudgetSeconds);
+	FindSessions(SessionTicket, true);
+}
+
+void AShooterGameSession::ContinueQuickJoin(const FString& SessionAddress)
+{
+	if (!SessionAddress.IsEmpty())
+	{
+		UE_LOG(LogOnlineGame, Display, TEXT("Quick join: joining session '%s'"), *SessionAddress);
+		FinishQuickJoin(TravelToSession(SessionAddress));
+		return;
+	}
+
+	// The budget no longer applies once the session is being created, the request is bounded by its own deadline and
+	// cancelling it could leave a session created by the session manager without anyone to join it
+	GetWorldTimerManager().ClearTimer(QuickJoinTimerHandle);
+	bQuickJoinCreatingSession = true;
+
+	UE_LOG(LogOnlineGame, Display, TEXT("Quick join: no session fits, creating one"));
+	HostSession(QuickJoinSettings.MaxNumPlayers, QuickJoinSettings.BotsCount, QuickJoinSessionTicket);
+}
+
+void AShooterGameSession::OnQuickJoinTimeout()
+{
+	UE_LOG(LogOnlineGame, Warning, TEXT("Quick join: no session joined within %.0f seconds"), QuickJoinSettings.BudgetSeconds);
+
+	CancelQuickJoin();
+	OnQuickJoinComplete().Broadcast(false);
+}
+
+void AShooterGameSession::CancelQuickJoin()
+{
+	if (!bQuickJoinInProgress)
+	{
+		return;
+	}
+
+	bQuickJoinInProgress = false;
+	GetWorldTimerManager().ClearTimer(QuickJoinTimerHandle);
+
+	// Neither the search nor the session being created are wanted anymore
+	CancelFindSessions();
+	if (HostSessionToken.IsValid())
+	{
+		if (bQuickJoinCreatingSession)
+		{
+			UE_LOG(LogOnlineGame, Warning, TEXT("Quick join: cancelled while creating a session of type '%s' in project '%s', a session may have been created without an owner"), *GetIMSSessionType(), *GetIMSProjectId());
+		}
+		HostSessionToken->Cancel();
+	}
+	bQuickJoinCreatingSession = false;
+
+	if (CurrentSessionSearch->SearchState == SearchState::InProgress)
+	{
+		CurrentSessionSearch->SearchState = SearchState::NotStarted;
+	}
+}
+
+void AShooterGameSession::FinishQuickJoin(bool bWasSuccessful)
+{
+	bQuickJoinInProgress = false;
+	bQuickJoinCreatingSession = false;
+	GetWorldTimerManager().ClearTimer(QuickJoinTimerHandle);
+
+	OnQuickJoinComplete().Broadcast(bWasSuccessful);
+}
+
 FString AShooterGameSession::CreateSessionConfigJson(const int32 MaxNumPlayers, const int32 BotsCount)
 {
 	UE_LOG(LogOnlineGame, Log, TEXT("Creating Session Config Json: MaxNumPlayers = %d, BotsCount = %d"), MaxNumPlayers, BotsCount);
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	JsonObject->SetNumberField("MaxNumPlayers", MaxNumPlayers);
-	JsonObject->SetNumberField("BotsCount", BotsCount);
 
-	FString SessionConfig;
-	TSharedRef< TJsonWriter<> > Writer = TJsonWriterFactory<>::Create(&SessionConfig);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	FShooterSessionConfig SessionConfig;
+	SessionConfig.MaxNumPlayers = MaxNumPlayers;
+	SessionConfig.BotsCount = BotsCount;
 
-	return SessionConfig;
+	return SessionConfig.Encode();
 }
 
 const SearchState AShooterGameSession::GetSearchSessionsStatus() const
@@ -146,26 +431,72 @@ const SearchState AShooterGameSession::GetSearchSessionsStatus() const
 	return CurrentSessionSearch->SearchState;
 }
 
-const TArray<Session>& AShooterGameSession::GetSearchResults() const
+const TArray<FSessionRecord>& AShooterGameSession::GetSearchResults() const
 {
 	return CurrentSessionSearch->SearchResults;
 }
 
-void AShooterGameSession::FindSessions(FString SessionTicket)
+int32 AShooterGameSession::GetSearchResultsRevision() const
+{
+	return CurrentSessionSearch->ResultsRevision;
+}
+
+void AShooterGameSession::FindSessions(FString SessionTicket, bool bBackground)
 {
 	// See the following doc for more information https://docs.ims.improbable.io/docs/ims-session-manager/guides/authetication
 	SessionManagerAPI->AddHeaderParam("Authorization", "Bearer playfab/" + SessionTicket);
 
-	IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Request Request;
-	Request.SetShouldRetry(RetryPolicy);
-	Request.ProjectId = GetIMSProjectId();
-	Request.SessionType = GetIMSSessionType();
+	// Results of a previous search would be stale by the time they arrive
+	CancelFindSessions();
+	FindSessionsToken = IMSOpenAPI::MakeCancellationToken();
+	bBackgroundSearch = bBackground;
+	FindSessionsStartTime = FPlatformTime::Seconds();
+
+	const TArray<FString> SessionTypes = GetIMSSearchSessionTypes();
+	SearchPools.SetNum(SessionTypes.Num());
 
-	UE_LOG(LogOnlineGame, Display, TEXT("Attempting to list sessions..."));
+	UE_LOG(LogOnlineGame, Display, TEXT("Attempting to list sessions of %d session types..."), SessionTypes.Num());
 	CurrentSessionSearch->SearchState = SearchState::InProgress;
-	SessionManagerAPI->ListSessionsV0(Request, OnFindSessionsCompleteDelegate);
 
-	FHttpModule::Get().GetHttpManager().Flush(false);
+	// The session types are listed concurrently, the search takes as long as the slowest one, bound by the same deadline
+	for (int32 PoolIndex = 0; PoolIndex < SessionTypes.Num(); ++PoolIndex)
+	{
+		SearchPools[PoolIndex].SessionType = SessionTypes[PoolIndex];
+
+		IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Request Request;
+		Request.SetShouldRetry(RetryPolicy);
+		Request.ProjectId = GetIMSProjectId();
+		Request.SessionType = SessionTypes[PoolIndex];
+		Request.SetCancellationToken(FindSessionsToken.ToSharedRef());
+		Request.SetDeadline(FindSessionsStartTime + RetryTimeoutRelativeSeconds);
+
+		SessionManagerAPI->ListSessionsV0(Request, IMSSessionManagerAPI::OpenAPISessionManagerV0Api::FListSessionsV0Delegate::CreateUObject(this, &AShooterGameSession::OnFindSessionsComplete, SearchSerial, PoolIndex));
+	}
+
+	// Requests completing right away may have completed the search already
+	if (CurrentSessionSearch->SearchState == SearchState::InProgress)
+	{
+		GetWorldTimerManager().SetTimer(FindSessionsTimerHandle, this, &AShooterGameSession::OnFindSessionsTimeout, RetryTimeoutRelativeSeconds, false);
+	}
+
+	// Flushing blocks until the requests complete, which would hitch the menu on every background refresh
+	if (!bBackground)
+	{
+		FHttpModule::Get().GetHttpManager().Flush(false);
+	}
+}
+
+void AShooterGameSession::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (SessionManagerAPI.IsValid())
+	{
+		SessionManagerAPI->CancelAllRequests();
+	}
+
+	CancelQuickJoin();
+	CancelFindSessions();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 bool AShooterGameSession::JoinSession(int32 SessionIndexInSearchResults)
@@ -174,10 +505,9 @@ bool AShooterGameSession::JoinSession(int32 SessionIndexInSearchResults)
 
 	if (SessionIndexInSearchResults >= 0 && SessionIndexInSearchResults < CurrentSessionSearch->SearchResults.Num())
 	{
-		Session SessionToJoin = CurrentSessionSearch->SearchResults[SessionIndexInSearchResults];
-		FString SessionAddress = SessionToJoin.GetSessionAddress();
+		const FSessionRecord& SessionToJoin = CurrentSessionSearch->SearchResults[SessionIndexInSearchResults];
 
-		if (TravelToSession(SessionAddress))
+		if (TravelToSession(SessionToJoin.GetSessionAddress()))
 		{
 			OnJoinSessionComplete().Broadcast(true);
 			return true;
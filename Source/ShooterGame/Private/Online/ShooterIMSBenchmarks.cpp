@@ -0,0 +1,412 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "OpenAPIV0ListSessionsResponse.h"
+#include "OpenAPIJsonStreamReader.h"
+#include "OpenAPIBase64.h"
+#include "Online/ShooterQosProber.h"
+#include "SessionSearch.h"
+#include "Misc/Base64.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	/** Builds a list sessions response body like the session manager returns, as UTF-8 */
+	TArray<uint8> MakeListSessionsBody(int32 NumSessions)
+	{
+		FString Json = TEXT("{\"sessions\":[");
+		for (int32 Index = 0; Index < NumSessions; ++Index)
+		{
+			if (Index > 0)
+			{
+				Json += TEXT(",");
+			}
+
+			Json += FString::Printf(TEXT("{\"id\":\"session-%05d\",\"address\":\"10.0.%d.%d\",\"ports\":[{\"name\":\"game\",\"port\":%d},{\"name\":\"beacon\",\"port\":%d}],")
+				TEXT("\"session_status\":{\"players\":\"%d\",\"max_players\":\"16\",\"map\":\"Highrise\",\"state\":\"InProgress\",\"note\":\"caf\\u00e9 \\\"%d\\\"\"}}"),
+				Index, Index / 256, Index % 256, 7777 + Index, 15000 + Index, Index % 17, Index);
+		}
+		Json += TEXT("]}");
+
+		FTCHARToUTF8 Converted(*Json);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	/** Decodes like the generated HandleResponse: wide string, FJsonValue DOM, then FromJson */
+	bool DecodeWithDom(const TArray<uint8>& Body, IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse& OutResponse)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+		const FString Content(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonValue> JsonValue;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+		return FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid() && OutResponse.FromJson(JsonValue);
+	}
+
+	bool DecodeWithStream(const TArray<uint8>& Body, IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse& OutResponse)
+	{
+		IMSSessionManagerAPI::JsonStreamReader Reader(Body.GetData(), Body.Num());
+		return OutResponse.FromJsonStream(Reader);
+	}
+
+	bool AreEqual(const IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse& A, const IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse& B)
+	{
+		if (A.Sessions.Num() != B.Sessions.Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < A.Sessions.Num(); ++Index)
+		{
+			const IMSSessionManagerAPI::OpenAPIV0Session& SessionA = A.Sessions[Index];
+			const IMSSessionManagerAPI::OpenAPIV0Session& SessionB = B.Sessions[Index];
+			if (SessionA.Id != SessionB.Id || SessionA.Address != SessionB.Address || SessionA.Ports.Num() != SessionB.Ports.Num()
+				|| !SessionA.SessionStatus.OrderIndependentCompareEqual(SessionB.SessionStatus))
+			{
+				return false;
+			}
+
+			for (int32 PortIndex = 0; PortIndex < SessionA.Ports.Num(); ++PortIndex)
+			{
+				if (SessionA.Ports[PortIndex].Name != SessionB.Ports[PortIndex].Name || SessionA.Ports[PortIndex].Port != SessionB.Ports[PortIndex].Port)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void BenchmarkJsonDecode(const TArray<FString>& Args)
+	{
+		const int32 NumSessions = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 50;
+
+		const TArray<uint8> Body = MakeListSessionsBody(NumSessions);
+
+		IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse DomResponse;
+		IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse StreamResponse;
+		if (!DecodeWithDom(Body, DomResponse) || !DecodeWithStream(Body, StreamResponse))
+		{
+			UE_LOG(LogShooter, Error, TEXT("JSON decode benchmark: failed to decode the generated body"));
+			return;
+		}
+
+		if (!AreEqual(DomResponse, StreamResponse))
+		{
+			UE_LOG(LogShooter, Error, TEXT("JSON decode benchmark: the streaming decode does not match the DOM decode"));
+			return;
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse Response;
+			DecodeWithDom(Body, Response);
+		}
+		const double DomSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			IMSSessionManagerAPI::OpenAPIV0ListSessionsResponse Response;
+			DecodeWithStream(Body, Response);
+		}
+		const double StreamSeconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogShooter, Display, TEXT("JSON decode benchmark: %d sessions, %d bytes, %d iterations"), NumSessions, Body.Num(), Iterations);
+		UE_LOG(LogShooter, Display, TEXT("  DOM:       %.3f ms per response"), DomSeconds * 1000.0 / Iterations);
+		UE_LOG(LogShooter, Display, TEXT("  Streaming: %.3f ms per response (x%.2f)"), StreamSeconds * 1000.0 / Iterations, StreamSeconds > 0.0 ? DomSeconds / StreamSeconds : 0.0);
+	}
+
+	/** Encodes like the generated helpers used to: FBase64 then a pass per substituted character */
+	FString EncodeWithFBase64(const TArray<uint8>& Bytes)
+	{
+		FString Base64String = FBase64::Encode(Bytes);
+		Base64String.ReplaceInline(TEXT("+"), TEXT("-"));
+		Base64String.ReplaceInline(TEXT("/"), TEXT("_"));
+		return Base64String;
+	}
+
+	bool DecodeWithFBase64(const FString& Base64String, TArray<uint8>& OutBytes)
+	{
+		FString TmpCopy(Base64String);
+		TmpCopy.ReplaceInline(TEXT("-"), TEXT("+"));
+		TmpCopy.ReplaceInline(TEXT("_"), TEXT("/"));
+		return FBase64::Decode(TmpCopy, OutBytes);
+	}
+
+	/** Checks the codec against FBase64 for every length up to MaxLength, and against malformed input */
+	bool CheckBase64Url(FRandomStream& Random, int32 MaxLength)
+	{
+		for (int32 Length = 0; Length <= MaxLength; ++Length)
+		{
+			TArray<uint8> Bytes;
+			Bytes.SetNumUninitialized(Length);
+			for (uint8& Byte : Bytes)
+			{
+				Byte = static_cast<uint8>(Random.RandRange(0, 255));
+			}
+
+			const FString Encoded = IMSOpenAPI::Base64UrlEncode(Bytes.GetData(), Bytes.Num());
+			if (Encoded != EncodeWithFBase64(Bytes))
+			{
+				UE_LOG(LogShooter, Error, TEXT("Base64 benchmark: encoding %d bytes does not match FBase64"), Length);
+				return false;
+			}
+
+			TArray<uint8> Decoded;
+			if (!IMSOpenAPI::Base64UrlDecode(*Encoded, Encoded.Len(), Decoded) || Decoded != Bytes)
+			{
+				UE_LOG(LogShooter, Error, TEXT("Base64 benchmark: decoding %d bytes does not round trip"), Length);
+				return false;
+			}
+
+			// Unpadded input, and the UTF-8 input of the JSON reader
+			FString Unpadded = Encoded;
+			Unpadded.RemoveFromEnd(TEXT("=="));
+			Unpadded.RemoveFromEnd(TEXT("="));
+			const FTCHARToUTF8 Utf8(*Unpadded, Unpadded.Len());
+			if (!IMSOpenAPI::Base64UrlDecode(Utf8.Get(), Utf8.Length(), Decoded) || Decoded != Bytes)
+			{
+				UE_LOG(LogShooter, Error, TEXT("Base64 benchmark: decoding %d unpadded bytes does not round trip"), Length);
+				return false;
+			}
+		}
+
+		const TCHAR* const Malformed[] = { TEXT("A"), TEXT("AAAAA"), TEXT("AA=A"), TEXT("AA AA"), TEXT("AA\u00e9A"), TEXT("A\x01AA") };
+		for (const TCHAR* String : Malformed)
+		{
+			TArray<uint8> Decoded;
+			if (IMSOpenAPI::Base64UrlDecode(String, FCString::Strlen(String), Decoded))
+			{
+				UE_LOG(LogShooter, Error, TEXT("Base64 benchmark: malformed input \"%s\" was decoded"), String);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void BenchmarkBase64(const TArray<FString>& Args)
+	{
+		const int32 NumBytes = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 64 * 1024;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+
+		FRandomStream Random(0x1D5);
+		if (!CheckBase64Url(Random, 256))
+		{
+			return;
+		}
+
+		TArray<uint8> Bytes;
+		Bytes.SetNumUninitialized(NumBytes);
+		for (uint8& Byte : Bytes)
+		{
+			Byte = static_cast<uint8>(Random.RandRange(0, 255));
+		}
+		const FString Encoded = IMSOpenAPI::Base64UrlEncode(Bytes.GetData(), Bytes.Num());
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			EncodeWithFBase64(Bytes);
+		}
+		const double FBase64EncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			IMSOpenAPI::Base64UrlEncode(Bytes.GetData(), Bytes.Num());
+		}
+		const double EncodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TArray<uint8> Decoded;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			DecodeWithFBase64(Encoded, Decoded);
+		}
+		const double FBase64DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			IMSOpenAPI::Base64UrlDecode(*Encoded, Encoded.Len(), Decoded);
+		}
+		const double DecodeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const double MegaBytes = static_cast<double>(NumBytes) * Iterations / (1024.0 * 1024.0);
+		UE_LOG(LogShooter, Display, TEXT("Base64 benchmark: %d bytes, %d iterations"), NumBytes, Iterations);
+		UE_LOG(LogShooter, Display, TEXT("  Encode: FBase64 %.1f MB/s, Base64Url %.1f MB/s (x%.2f)"), MegaBytes / FBase64EncodeSeconds, MegaBytes / EncodeSeconds,
+			EncodeSeconds > 0.0 ? FBase64EncodeSeconds / EncodeSeconds : 0.0);
+		UE_LOG(LogShooter, Display, TEXT("  Decode: FBase64 %.1f MB/s, Base64Url %.1f MB/s (x%.2f)"), MegaBytes / FBase64DecodeSeconds, MegaBytes / DecodeSeconds,
+			DecodeSeconds > 0.0 ? FBase64DecodeSeconds / DecodeSeconds : 0.0);
+	}
+
+	FSessionRecord MakeRankedSession(const TCHAR* Id, float LatencyMs, float PacketLoss, int32 NumPlayers, const TCHAR* GamePhase, const TCHAR* MapName = TEXT("Sanctuary"))
+	{
+		IMSSessionManagerAPI::OpenAPIV0Session SessionResponse;
+		SessionResponse.Id = Id;
+		SessionResponse.Address = TEXT("127.0.0.1");
+		SessionResponse.SessionStatus.Add(TEXT("CurrentNumPlayers"), FString::FromInt(NumPlayers));
+		SessionResponse.SessionStatus.Add(TEXT("MaxNumPlayers"), TEXT("8"));
+		SessionResponse.SessionStatus.Add(TEXT("GamePhase"), GamePhase);
+		SessionResponse.SessionStatus.Add(TEXT("MapName"), MapName);
+
+		FSessionRecord Result(SessionResponse);
+		Result.Qos.LatencyMs = LatencyMs;
+		Result.Qos.PacketLoss = PacketLoss;
+		return Result;
+	}
+
+	bool CheckRanking()
+	{
+		SessionSearch Search;
+		Search.MaxSearchResults = 5;
+		Search.PendingResults.Add(MakeRankedSession(TEXT("unreachable"), -1.0f, 1.0f, 7, TEXT("InProgress")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("lossy"), 5.0f, 0.5f, 7, TEXT("InProgress")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("full"), 5.0f, 0.0f, 8, TEXT("InProgress")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("far"), 150.0f, 0.0f, 7, TEXT("InProgress")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("near-empty"), 12.0f, 0.0f, 1, TEXT("WaitingToStart")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("near-busy"), 8.0f, 0.0f, 5, TEXT("InProgress")));
+		Search.PendingResults.Add(MakeRankedSession(TEXT("post-match"), 5.0f, 0.0f, 2, TEXT("WaitingPostMatch")));
+		Search.CompleteWithRankedResults();
+
+		// Close enough latencies are ranked by fill ratio, full and ended sessions after the joinable ones
+		const TCHAR* const Expected[] = { TEXT("near-busy"), TEXT("near-empty"), TEXT("far"), TEXT("full"), TEXT("post-match") };
+		const int32 NumExpected = UE_ARRAY_COUNT(Expected);
+		bool bRanked = Search.SearchResults.Num() == NumExpected;
+		for (int32 Index = 0; bRanked && Index < NumExpected; ++Index)
+		{
+			bRanked = Search.SearchResults[Index].Id == Expected[Index];
+		}
+
+		if (!bRanked)
+		{
+			UE_LOG(LogShooter, Error, TEXT("QoS benchmark: the sessions are not ranked as expected"));
+		}
+		return bRanked;
+	}
+
+	bool CheckQuickJoinSelection()
+	{
+		SessionSearch Search;
+		TArray<FSessionRecord> Results;
+		Results.Add(MakeRankedSession(TEXT("full"), 5.0f, 0.0f, 8, TEXT("InProgress"), TEXT("Highrise")));
+		Results.Add(MakeRankedSession(TEXT("too-far"), 200.0f, 0.0f, 7, TEXT("InProgress"), TEXT("Highrise")));
+		Results.Add(MakeRankedSession(TEXT("post-match"), 5.0f, 0.0f, 2, TEXT("WaitingPostMatch"), TEXT("Highrise")));
+		Results.Add(MakeRankedSession(TEXT("near-other-map"), 10.0f, 0.0f, 4, TEXT("InProgress"), TEXT("Sanctuary")));
+		Results.Add(MakeRankedSession(TEXT("near-preferred-map"), 15.0f, 0.0f, 4, TEXT("InProgress"), TEXT("Highrise")));
+
+		// Sessions that cannot be joined are never picked, the preferred map wins between close enough sessions
+		const FSessionRecord* Preferred = Search.FindQuickJoinSession(Results, TEXT("highrise"));
+		const FSessionRecord* AnyMap = Search.FindQuickJoinSession(Results, FString());
+		const FSessionRecord* None = Search.FindQuickJoinSession(TArray<FSessionRecord>(Results.GetData(), 3), TEXT("Highrise"));
+
+		const bool bSelected = Preferred && Preferred->Id == TEXT("near-preferred-map") && AnyMap && AnyMap->Id == TEXT("near-other-map") && !None;
+		if (!bSelected)
+		{
+			UE_LOG(LogShooter, Error, TEXT("QoS benchmark: the quick join does not pick the expected sessions"));
+		}
+		return bSelected;
+	}
+
+	/** Echo servers standing in for game servers and the prober measuring them, kept until the probes complete */
+	struct FQosBenchmark
+	{
+		TArray<TUniquePtr<FShooterQosEchoServer>> EchoServers;
+		TUniquePtr<FShooterQosProber> Prober;
+		double StartTime;
+	};
+	TUniquePtr<FQosBenchmark> QosBenchmark;
+
+	void OnQosBenchmarkComplete(const TArray<FShooterQosResult>& Results, float DelayedLatencyMs)
+	{
+		const double Seconds = FPlatformTime::Seconds() - QosBenchmark->StartTime;
+
+		// Targets: immediate echo, delayed echo, echo dropping everything, unparsable address
+		const bool bImmediate = Results[0].IsReachable() && Results[0].PacketLoss == 0.0f && Results[0].LatencyMs < DelayedLatencyMs;
+		const bool bDelayed = Results[1].IsReachable() && Results[1].PacketLoss == 0.0f && Results[1].LatencyMs >= DelayedLatencyMs;
+		const bool bDropped = !Results[2].IsReachable() && Results[2].PacketLoss == 1.0f;
+		const bool bInvalid = !Results[3].IsReachable() && Results[3].PacketLoss == 1.0f;
+
+		if (bImmediate && bDelayed && bDropped && bInvalid)
+		{
+			UE_LOG(LogShooter, Display, TEXT("QoS benchmark: probed in %.0f ms, loopback %.3f ms, delayed %.1f ms (%.0f ms injected)"),
+				Seconds * 1000.0, Results[0].LatencyMs, Results[1].LatencyMs, DelayedLatencyMs);
+		}
+		else
+		{
+			UE_LOG(LogShooter, Error, TEXT("QoS benchmark: unexpected results, loopback %.3f ms %.0f%% loss, delayed %.1f ms %.0f%% loss, dropped %.0f%% loss"),
+				Results[0].LatencyMs, Results[0].PacketLoss * 100.0f, Results[1].LatencyMs, Results[1].PacketLoss * 100.0f, Results[2].PacketLoss * 100.0f);
+		}
+
+		// Released on the next tick, the prober is still executing the callback
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+		{
+			QosBenchmark.Reset();
+			return false;
+		}));
+	}
+
+	void BenchmarkQos(const TArray<FString>& Args)
+	{
+		const float DelayedLatencyMs = Args.Num() > 0 ? FMath::Max(1.0f, FCString::Atof(*Args[0])) : 50.0f;
+		const int32 NumSamples = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 4;
+
+		if (QosBenchmark.IsValid())
+		{
+			UE_LOG(LogShooter, Warning, TEXT("QoS benchmark: already running"));
+			return;
+		}
+
+		if (!CheckRanking() || !CheckQuickJoinSelection())
+		{
+			return;
+		}
+
+		QosBenchmark = MakeUnique<FQosBenchmark>();
+		QosBenchmark->EchoServers.Add(MakeUnique<FShooterQosEchoServer>(0));
+		QosBenchmark->EchoServers.Add(MakeUnique<FShooterQosEchoServer>(0, DelayedLatencyMs));
+		QosBenchmark->EchoServers.Add(MakeUnique<FShooterQosEchoServer>(0, 0.0f, 1.0f));
+		for (const TUniquePtr<FShooterQosEchoServer>& EchoServer : QosBenchmark->EchoServers)
+		{
+			if (!EchoServer->IsListening())
+			{
+				UE_LOG(LogShooter, Error, TEXT("QoS benchmark: failed to start the echo servers"));
+				QosBenchmark.Reset();
+				return;
+			}
+		}
+
+		QosBenchmark->Prober = MakeUnique<FShooterQosProber>(NumSamples, 0.05f, 1.0f);
+		for (const TUniquePtr<FShooterQosEchoServer>& EchoServer : QosBenchmark->EchoServers)
+		{
+			QosBenchmark->Prober->AddTarget(TEXT("127.0.0.1"), EchoServer->GetPort());
+		}
+		QosBenchmark->Prober->AddTarget(TEXT("not-an-address"), 7777);
+
+		QosBenchmark->StartTime = FPlatformTime::Seconds();
+		QosBenchmark->Prober->Start([DelayedLatencyMs](const TArray<FShooterQosResult>& Results)
+		{
+			OnQosBenchmarkComplete(Results, DelayedLatencyMs);
+		});
+	}
+}
+
+static FAutoConsoleCommand IMSBenchmarkJsonDecodeCmd(
+	TEXT("ims.Benchmark.JsonDecode"),
+	TEXT("Compares the DOM and streaming decoding of a list sessions response. Usage: ims.Benchmark.JsonDecode [NumSessions] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkJsonDecode));
+
+static FAutoConsoleCommand IMSBenchmarkBase64Cmd(
+	TEXT("ims.Benchmark.Base64"),
+	TEXT("Checks the Base64Url codec against FBase64 and compares their throughput. Usage: ims.Benchmark.Base64 [NumBytes] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkBase64));
+
+static FAutoConsoleCommand IMSBenchmarkQosCmd(
+	TEXT("ims.Benchmark.Qos"),
+	TEXT("Checks the session ranking and the quick join selection, then probes local QoS echo servers and reports the measured latencies. Usage: ims.Benchmark.Qos [InjectedLatencyMs] [NumSamples]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkQos));
@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterIMSClient.h"
+#include "Online/ShooterIMSTransport.h"
+#include "OpenAPIInstrumentation.h"
+
+namespace
+{
+	/**
+	 * Owned by the completion delegate of an attempt. The API drops the delegate without calling it when the attempt
+	 * is not issued or is cancelled, in which case the breaker trial taken by the attempt is given back.
+	 */
+	struct FShooterIMSAttemptGuard
+	{
+		FString Endpoint;
+		bool bTrial = false;
+		bool bResultRecorded = false;
+
+		~FShooterIMSAttemptGuard()
+		{
+			if (bTrial && !bResultRecorded)
+			{
+				FShooterIMSTransport::Get().ReleaseTrial(Endpoint);
+			}
+		}
+	};
+}
+
+FShooterIMSClient::FShooterIMSClient()
+	: PayloadLocalAPI(MakeShared<IMSZeuzAPI::OpenAPIPayloadLocalApi>())
+	, SessionManagerLocalAPI(MakeShared<IMSZeuzAPI::OpenAPISessionManagerLocalApi>())
+	, RetryManager(DefaultRetryLimitCount, DefaultRetryTimeoutSeconds)
+{
+	PayloadLocalAPI->SetHttpRetryManager(RetryManager);
+	SessionManagerLocalAPI->SetHttpRetryManager(RetryManager);
+}
+
+FShooterIMSClient::~FShooterIMSClient()
+{
+}
+
+void FShooterIMSClient::SetURL(const FString& Url)
+{
+	PendingRequests.Enqueue([this, Url]()
+	{
+		PayloadLocalAPI->SetURL(Url);
+		SessionManagerLocalAPI->SetURL(Url);
+	});
+}
+
+template<typename ResponseType, typename ApiType, typename RequestType, typename DelegateType>
+void FShooterIMSClient::QueueRequest(const TSharedRef<ApiType>& Api, FHttpRequestPtr (ApiType::*Operation)(const RequestType&, const DelegateType&) const, const RequestType& Request, const DelegateType& Delegate)
+{
+	const int32 CancelGeneration = CancelCounter.GetValue();
+	PendingRequests.Enqueue([this, Api, Operation, Request, Delegate, CancelGeneration]()
+	{
+		// Requests without a retry policy are attempted once, the limits of the engine retry policy are kept otherwise
+		FRetryState RetryState;
+		RetryState.CancelGeneration = CancelGeneration;
+		if (Request.GetRetryParams().IsSet())
+		{
+			const IMSZeuzAPI::HttpRetryParams& Params = Request.GetRetryParams().GetValue();
+			RetryState.MaxRetries = Params.RetryLimitCountOverride.IsSet() ? static_cast<int32>(Params.RetryLimitCountOverride.GetValue()) : DefaultRetryLimitCount;
+			RetryState.Deadline = FPlatformTime::Seconds() + (Params.RetryTimeoutRelativeSecondsOverride.IsSet() ? Params.RetryTimeoutRelativeSecondsOverride.GetValue() : DefaultRetryTimeoutSeconds);
+		}
+
+		// Retries are not scheduled past the deadline of the request
+		if (Request.GetDeadline().IsSet())
+		{
+			RetryState.Deadline = FMath::Min(RetryState.Deadline, Request.GetDeadline().GetValue());
+		}
+
+		IssueRequest<ResponseType>(Api, Operation, Request, Delegate, RetryState);
+	});
+}
+
+template<typename ResponseType, typename ApiType, typename RequestType, typename DelegateType>
+void FShooterIMSClient::IssueRequest(const TSharedRef<ApiType>& Api, FHttpRequestPtr (ApiType::*Operation)(const RequestType&, const DelegateType&) const, const RequestType& Request, const DelegateType& Delegate, const FRetryState& RetryState)
+{
+	if (IsCancelled(Request, RetryState))
+	{
+		return;
+	}
+
+	if (Request.HasDeadlinePassed())
+	{
+		CompleteRequest<ResponseType>(Request, Delegate, RetryState, EHttpResponseCodes::RequestTimeout);
+		return;
+	}
+
+	const FString Endpoint = Request.ComputePath();
+
+	const TSharedRef<FShooterIMSAttemptGuard, ESPMode::ThreadSafe> AttemptGuard = MakeShared<FShooterIMSAttemptGuard, ESPMode::ThreadSafe>();
+	AttemptGuard->Endpoint = Endpoint;
+	if (!FShooterIMSTransport::Get().AllowRequest(Endpoint, &AttemptGuard->bTrial))
+	{
+		CompleteRequest<ResponseType>(Request, Delegate, RetryState, EHttpResponseCodes::ServiceUnavail);
+		return;
+	}
+
+	// Engine retries are disabled, the attempts are retried here following the transport policy
+	RequestType Attempt = Request;
+	Attempt.SetShouldRetry(IMSZeuzAPI::HttpRetryParams(0));
+
+	// Called from the HTTP manager tick on the game thread, the delegate is deferred to ProcessResponses
+	const FHttpRequestPtr HttpRequest = ((*Api).*Operation)(Attempt, DelegateType::CreateLambda([this, Api, Operation, Request, Delegate, RetryState, Endpoint, AttemptGuard](const ResponseType& Response)
+	{
+		const bool bRetryable = !Response.IsSuccessful() && FShooterIMSTransport::IsRetryableResponseCode(Response.GetHttpResponseCode());
+		AttemptGuard->bResultRecorded = true;
+		FShooterIMSTransport::Get().RecordResult(Endpoint, !bRetryable);
+
+		if (bRetryable && RetryState.NumRetries < RetryState.MaxRetries)
+		{
+			FRetryState NextRetryState = RetryState;
+			NextRetryState.RetryDelay = FShooterIMSTransport::Get().GetRetryDelay(RetryState.RetryDelay);
+			++NextRetryState.NumRetries;
+
+			const double RetryTime = FPlatformTime::Seconds() + NextRetryState.RetryDelay;
+			if (RetryTime < RetryState.Deadline && FShooterIMSTransport::Get().TryConsumeRetry())
+			{
+				IMSOpenAPI::FInstrumentation::Get().RecordRetry(Request.GetOperationName());
+				DelayedRequests.Emplace(RetryTime, [this, Api, Operation, Request, Delegate, NextRetryState]()
+				{
+					IssueRequest<ResponseType>(Api, Operation, Request, Delegate, NextRetryState);
+				});
+				return;
+			}
+		}
+
+		CompletedResponses.Enqueue([this, Request, Delegate, Response, RetryState]()
+		{
+			if (!IsCancelled(Request, RetryState))
+			{
+				Delegate.ExecuteIfBound(Response);
+			}
+		});
+	}));
+
+	// The API did not issue the attempt (invalid URL, deadline passed or token cancelled) and drops the delegate without calling it
+	if (!HttpRequest.IsValid() && !IsCancelled(Request, RetryState))
+	{
+		CompleteRequest<ResponseType>(Request, Delegate, RetryState, Request.HasDeadlinePassed() ? EHttpResponseCodes::RequestTimeout : EHttpResponseCodes::Unknown);
+	}
+}
+
+template<typename ResponseType, typename RequestType, typename DelegateType>
+void FShooterIMSClient::CompleteRequest(const RequestType& Request, const DelegateType& Delegate, const FRetryState& RetryState, EHttpResponseCodes::Type ResponseCode)
+{
+	ResponseType Response;
+	Response.SetHttpResponseCode(ResponseCode);
+	CompletedResponses.Enqueue([this, Request, Delegate, Response, RetryState]()
+	{
+		if (!IsCancelled(Request, RetryState))
+		{
+			Delegate.ExecuteIfBound(Response);
+		}
+	});
+}
+
+bool FShooterIMSClient::IsCancelled(const IMSZeuzAPI::Request& Request, const FRetryState& RetryState) const
+{
+	return Request.IsCancelled() || RetryState.CancelGeneration != CancelCounter.GetValue();
+}
+
+void FShooterIMSClient::CancelAllRequests()
+{
+	// Requests queued before this point and the responses still to be delivered are dropped from now on
+	CancelCounter.Increment();
+
+	PendingRequests.Enqueue([this]()
+	{
+		PayloadLocalAPI->CancelAllRequests();
+		SessionManagerLocalAPI->CancelAllRequests();
+		DelayedRequests.Reset();
+	});
+}
+
+void FShooterIMSClient::GetPayloadV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FGetPayloadV0Delegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Response>(PayloadLocalAPI, &IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0, Request, Delegate);
+}
+
+void FShooterIMSClient::ReadyV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FReadyV0Delegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Response>(PayloadLocalAPI, &IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0, Request, Delegate);
+}
+
+void FShooterIMSClient::SetAnnotationV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetAnnotationV0Delegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0Response>(PayloadLocalAPI, &IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0, Request, Delegate);
+}
+
+void FShooterIMSClient::SetLabelV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetLabelV0Delegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0Response>(PayloadLocalAPI, &IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0, Request, Delegate);
+}
+
+void FShooterIMSClient::GetSessionConfigV0(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0Request& Request, const IMSZeuzAPI::OpenAPISessionManagerLocalApi::FGetSessionConfigV0Delegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0Response>(SessionManagerLocalAPI, &IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0, Request, Delegate);
+}
+
+void FShooterIMSClient::ApiV0SessionManagerStatusPost(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest& Request, const IMSZeuzAPI::OpenAPISessionManagerLocalApi::FApiV0SessionManagerStatusPostDelegate& Delegate)
+{
+	QueueRequest<IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse>(SessionManagerLocalAPI, &IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPost, Request, Delegate);
+}
+
+void FShooterIMSClient::ProcessRequests()
+{
+	check(IsInGameThread());
+
+	TUniqueFunction<void()> Work;
+	while (PendingRequests.Dequeue(Work))
+	{
+		Work();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = DelayedRequests.Num() - 1; Index >= 0; --Index)
+	{
+		if (DelayedRequests[Index].Key <= Now)
+		{
+			Work = MoveTemp(DelayedRequests[Index].Value);
+			DelayedRequests.RemoveAtSwap(Index, 1, false);
+			Work();
+		}
+	}
+
+	RetryManager.Update();
+}
+
+void FShooterIMSClient::ProcessResponses()
+{
+	check(IsInGameThread());
+
+	TUniqueFunction<void()> Completion;
+	while (CompletedResponses.Dequeue(Completion))
+	{
+		Completion();
+	}
+}
+
+bool FShooterIMSClient::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterIMSClient_Tick);
+
+	ProcessRequests();
+	ProcessResponses();
+
+	return true;
+}
@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterIMSTransport.h"
+
+static FAutoConsoleCommand IMSTransportStatsCmd(
+	TEXT("ims.Transport.Stats"),
+	TEXT("Logs the retry counters and the circuit breaker state of the IMS endpoints"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FShooterIMSTransport::Get().DumpStats();
+	}));
+
+FShooterIMSTransport& FShooterIMSTransport::Get()
+{
+	static FShooterIMSTransport Transport;
+	return Transport;
+}
+
+FShooterIMSTransport::FShooterIMSTransport()
+	: RetryBudget(Settings.RetryBudgetBurst)
+	, LastRetryBudgetRefill(FPlatformTime::Seconds())
+{
+}
+
+void FShooterIMSTransport::SetSettings(const FShooterIMSTransportSettings& InSettings)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	Settings = InSettings;
+	RetryBudget = FMath::Min(RetryBudget, Settings.RetryBudgetBurst);
+}
+
+bool FShooterIMSTransport::AllowRequest(const FString& Endpoint, bool* bOutTrial /*= nullptr*/)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const double Now = FPlatformTime::Seconds();
+	FEndpointBreaker& Breaker = Breakers.FindOrAdd(Endpoint);
+	if (Breaker.State == EBreakerState::Open && Now >= Breaker.OpenUntil)
+	{
+		Breaker.State = EBreakerState::HalfOpen;
+		Breaker.bTrialInFlight = false;
+	}
+
+	// A trial that never reports back (dropped or cancelled) must not keep the endpoint closed for good
+	if (Breaker.State == EBreakerState::HalfOpen && Breaker.bTrialInFlight && Now - Breaker.TrialStartTime >= Settings.BreakerCooldownSeconds)
+	{
+		UE_LOG(LogGameMode, Log, TEXT("IMS endpoint %s trial request did not complete within %.1fs, allowing another one"), *Endpoint, Settings.BreakerCooldownSeconds);
+		Breaker.bTrialInFlight = false;
+	}
+
+	// While half open a single trial request decides whether the breaker closes or opens again
+	const bool bAllowed = Breaker.State == EBreakerState::Closed || (Breaker.State == EBreakerState::HalfOpen && !Breaker.bTrialInFlight);
+	if (bAllowed)
+	{
+		Breaker.bTrialInFlight = Breaker.State == EBreakerState::HalfOpen;
+		Breaker.TrialStartTime = Now;
+		++Stats.Attempts;
+	}
+	else
+	{
+		++Stats.RejectedByBreaker;
+	}
+
+	if (bOutTrial != nullptr)
+	{
+		*bOutTrial = bAllowed && Breaker.bTrialInFlight;
+	}
+
+	return bAllowed;
+}
+
+void FShooterIMSTransport::RecordResult(const FString& Endpoint, bool bEndpointAvailable)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FEndpointBreaker& Breaker = Breakers.FindOrAdd(Endpoint);
+	Breaker.bTrialInFlight = false;
+
+	if (bEndpointAvailable)
+	{
+		Breaker.State = EBreakerState::Closed;
+		Breaker.ConsecutiveFailures = 0;
+		return;
+	}
+
+	++Breaker.ConsecutiveFailures;
+	if (Breaker.State == EBreakerState::HalfOpen || (Breaker.State == EBreakerState::Closed && Breaker.ConsecutiveFailures >= Settings.BreakerFailureThreshold))
+	{
+		UE_LOG(LogGameMode, Warning, TEXT("IMS endpoint %s is unavailable after %d consecutive failures, pausing its requests for %.1fs"), *Endpoint, Breaker.ConsecutiveFailures, Settings.BreakerCooldownSeconds);
+
+		Breaker.State = EBreakerState::Open;
+		Breaker.OpenUntil = FPlatformTime::Seconds() + Settings.BreakerCooldownSeconds;
+		++Stats.BreakerTrips;
+	}
+}
+
+void FShooterIMSTransport::ReleaseTrial(const FString& Endpoint)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (FEndpointBreaker* Breaker = Breakers.Find(Endpoint))
+	{
+		if (Breaker->State == EBreakerState::HalfOpen)
+		{
+			Breaker->bTrialInFlight = false;
+		}
+	}
+}
+
+bool FShooterIMSTransport::TryConsumeRetry()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const double Now = FPlatformTime::Seconds();
+	RetryBudget = FMath::Min(Settings.RetryBudgetBurst, RetryBudget + static_cast<float>(Now - LastRetryBudgetRefill) * Settings.RetryBudgetPerSecond);
+	LastRetryBudgetRefill = Now;
+
+	if (RetryBudget < 1.0f)
+	{
+		++Stats.RetriesOverBudget;
+		return false;
+	}
+
+	RetryBudget -= 1.0f;
+	++Stats.Retries;
+	return true;
+}
+
+float FShooterIMSTransport::GetRetryDelay(float PreviousDelay) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	// Decorrelated jitter: the next delay is drawn between the base delay and three times the previous one
+	const float UpperBound = FMath::Max(PreviousDelay, Settings.BaseRetryDelay) * 3.0f;
+	return FMath::Min(Settings.MaxRetryDelay, FMath::FRandRange(Settings.BaseRetryDelay, UpperBound));
+}
+
+bool FShooterIMSTransport::IsRetryableResponseCode(EHttpResponseCodes::Type ResponseCode)
+{
+	// Connection failures are reported as timeouts by the generated APIs
+	return ResponseCode == EHttpResponseCodes::RequestTimeout
+		|| ResponseCode == EHttpResponseCodes::TooManyRequests
+		|| ResponseCode >= EHttpResponseCodes::ServerError;
+}
+
+FShooterIMSTransportStats FShooterIMSTransport::GetStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return Stats;
+}
+
+const TCHAR* FShooterIMSTransport::LexToString(EBreakerState State)
+{
+	switch (State)
+	{
+	case EBreakerState::Closed:
+		return TEXT("Closed");
+	case EBreakerState::Open:
+		return TEXT("Open");
+	case EBreakerState::HalfOpen:
+		return TEXT("HalfOpen");
+	}
+
+	return TEXT("Unknown");
+}
+
+void FShooterIMSTransport::DumpStats() const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	UE_LOG(LogGameMode, Display, TEXT("IMS transport: Attempts = %u, Retries = %u, RetriesOverBudget = %u, RejectedByBreaker = %u, BreakerTrips = %u, RetryBudget = %.1f"),
+		Stats.Attempts, Stats.Retries, Stats.RetriesOverBudget, Stats.RejectedByBreaker, Stats.BreakerTrips, RetryBudget);
+
+	for (const TPair<FString, FEndpointBreaker>& Breaker : Breakers)
+	{
+		UE_LOG(LogGameMode, Display, TEXT("IMS endpoint %s: %s, ConsecutiveFailures = %d"), *Breaker.Key, LexToString(Breaker.Value.State), Breaker.Value.ConsecutiveFailures);
+	}
+}
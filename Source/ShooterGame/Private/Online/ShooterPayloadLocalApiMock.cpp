@@ -0,0 +1,391 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterPayloadLocalApiMock.h"
+
+#if WITH_SHOOTER_PAYLOAD_MOCK
+
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "HttpPath.h"
+#include "OpenAPIGetPayloadResponseV0.h"
+#include "OpenAPISessionConfigV0.h"
+#include "OpenAPISetAnnotationRequestV0.h"
+#include "OpenAPIErrorResponseV0.h"
+#include "OpenAPIHelpers.h"
+
+TUniquePtr<FShooterPayloadLocalApiMock> FShooterPayloadLocalApiMock::Instance;
+
+namespace
+{
+	const uint32 DefaultPort = 8089;
+	const TCHAR* DefaultScript = TEXT("Reserved:5");
+
+	FString ToJson(const IMSZeuzAPI::Model& Model)
+	{
+		return IMSZeuzAPI::ToString(Model);
+	}
+
+	TSharedPtr<FJsonValue> ParseBody(const FHttpServerRequest& Request)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+		const FString Body(Converter.Length(), Converter.Get());
+
+		TSharedPtr<FJsonValue> JsonValue;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+		if (!FJsonSerializer::Deserialize(Reader, JsonValue))
+		{
+			return nullptr;
+		}
+
+		return JsonValue;
+	}
+}
+
+void FShooterPayloadLocalApiMock::Initialize()
+{
+	if (!Instance.IsValid() && IsEnabled())
+	{
+		uint32 Port = DefaultPort;
+		FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockPort="), Port);
+
+		Instance = MakeUnique<FShooterPayloadLocalApiMock>(Port);
+	}
+}
+
+void FShooterPayloadLocalApiMock::Shutdown()
+{
+	Instance.Reset();
+}
+
+bool FShooterPayloadLocalApiMock::IsEnabled()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("zeuz-mock"));
+}
+
+FShooterPayloadLocalApiMock::FShooterPayloadLocalApiMock(uint32 InPort)
+	: Port(InPort)
+	, PayloadId(FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower))
+	, Created(FDateTime::UtcNow())
+	, State(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Starting)
+	, NextStepTime(0.0)
+	, LatencyMs(0.0f)
+	, ErrorRate(0.0f)
+	, ErrorCode(500)
+	, DropRate(0.0f)
+{
+	FString ScriptString = DefaultScript;
+	FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockScript="), ScriptString);
+	if (!ParseScript(ScriptString, Script))
+	{
+		UE_LOG(LogShooter, Error, TEXT("Payload Local API mock: invalid script '%s', expected <State>:<Seconds>,..."), *ScriptString);
+		Script.Reset();
+	}
+
+	float FaultValue = 0.0f;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockLatencyMs="), FaultValue))
+	{
+		SetLatency(FaultValue);
+	}
+	if (FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockErrorRate="), FaultValue))
+	{
+		SetErrorRate(FaultValue);
+	}
+	FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockErrorCode="), ErrorCode);
+	if (FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockDropRate="), FaultValue))
+	{
+		SetDropRate(FaultValue);
+	}
+	FParse::Value(FCommandLine::Get(), TEXT("ZeuzMockSessionConfig="), SessionConfig);
+
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+	if (Router.IsValid())
+	{
+		BindRoutes();
+		FHttpServerModule::Get().StartAllListeners();
+
+		UE_LOG(LogShooter, Display, TEXT("Payload Local API mock listening on %s"), *GetURL());
+	}
+	else
+	{
+		UE_LOG(LogShooter, Error, TEXT("Payload Local API mock: failed to create an HTTP router on port %u"), Port);
+	}
+
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.ZeuzMock.SetState"), TEXT("Moves the mocked payload to the given state, e.g. ims.ZeuzMock.SetState Reserved"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState;
+			if (Args.Num() == 1 && IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumFromString(Args[0], NewState))
+			{
+				SetState(NewState);
+			}
+		})));
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.ZeuzMock.Latency"), TEXT("Sets the latency of the mocked responses in milliseconds"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SetLatency(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f);
+		})));
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.ZeuzMock.Errors"), TEXT("Sets the ratio of requests that fail and optionally their response code, e.g. ims.ZeuzMock.Errors 0.1 503"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SetErrorRate(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f);
+			if (Args.Num() > 1)
+			{
+				ErrorCode = FCString::Atoi(*Args[1]);
+			}
+		})));
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.ZeuzMock.Drops"), TEXT("Sets the ratio of requests that are never answered"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SetDropRate(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f);
+		})));
+}
+
+FShooterPayloadLocalApiMock::~FShooterPayloadLocalApiMock()
+{
+	for (IConsoleObject* ConsoleCommand : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleCommand);
+	}
+
+	if (Router.IsValid())
+	{
+		for (const FHttpRouteHandle& RouteHandle : RouteHandles)
+		{
+			Router->UnbindRoute(RouteHandle);
+		}
+	}
+}
+
+FString FShooterPayloadLocalApiMock::GetURL() const
+{
+	return FString::Printf(TEXT("http://localhost:%u"), Port);
+}
+
+bool FShooterPayloadLocalApiMock::ParseScript(const FString& ScriptString, TArray<FScriptStep>& OutSteps)
+{
+	TArray<FString> Steps;
+	ScriptString.ParseIntoArray(Steps, TEXT(","));
+
+	for (const FString& Step : Steps)
+	{
+		FString StateString;
+		FString DelayString;
+		if (!Step.Split(TEXT(":"), &StateString, &DelayString))
+		{
+			return false;
+		}
+
+		FScriptStep& ScriptStep = OutSteps.AddDefaulted_GetRef();
+		if (!IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumFromString(StateString.TrimStartAndEnd(), ScriptStep.State) || !DelayString.IsNumeric())
+		{
+			return false;
+		}
+		ScriptStep.Delay = FMath::Max(FCString::Atof(*DelayString), 0.0f);
+	}
+
+	return true;
+}
+
+void FShooterPayloadLocalApiMock::BindRoutes()
+{
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/payload")), EHttpServerRequestVerbs::VERB_GET,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleGetPayload(Request, OnComplete); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/ready")), EHttpServerRequestVerbs::VERB_POST,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleReady(Request, OnComplete); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/metadata/annotation")), EHttpServerRequestVerbs::VERB_PUT,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleSetMetadata(Request, OnComplete, Annotations); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/metadata/label")), EHttpServerRequestVerbs::VERB_PUT,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleSetMetadata(Request, OnComplete, Labels); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/session-manager/status")), EHttpServerRequestVerbs::VERB_GET,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleGetSessionStatus(Request, OnComplete); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/session-manager/status")), EHttpServerRequestVerbs::VERB_POST,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleSetSessionStatus(Request, OnComplete); }));
+	RouteHandles.Add(Router->BindRoute(FHttpPath(TEXT("/api/v0/session-manager/config")), EHttpServerRequestVerbs::VERB_GET,
+		[this](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete) { return HandleGetSessionConfig(Request, OnComplete); }));
+}
+
+void FShooterPayloadLocalApiMock::SetState(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState)
+{
+	Script.Reset();
+	EnterState(NewState);
+}
+
+void FShooterPayloadLocalApiMock::SetLatency(float InLatencyMs)
+{
+	LatencyMs = FMath::Max(InLatencyMs, 0.0f);
+}
+
+void FShooterPayloadLocalApiMock::SetErrorRate(float InErrorRate)
+{
+	ErrorRate = FMath::Clamp(InErrorRate, 0.0f, 1.0f);
+}
+
+void FShooterPayloadLocalApiMock::SetDropRate(float InDropRate)
+{
+	DropRate = FMath::Clamp(InDropRate, 0.0f, 1.0f);
+}
+
+void FShooterPayloadLocalApiMock::EnterState(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState)
+{
+	UE_LOG(LogShooter, Display, TEXT("Payload Local API mock: payload state %s -> %s"), *IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumToString(State), *IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumToString(NewState));
+
+	State = NewState;
+	if (State == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Reserved)
+	{
+		LastReserved = FDateTime::UtcNow();
+	}
+
+	if (Script.Num() > 0)
+	{
+		NextStepTime = FPlatformTime::Seconds() + Script[0].Delay;
+	}
+}
+
+bool FShooterPayloadLocalApiMock::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Scripted transitions only start once the game server has set the payload to Ready
+	if (Script.Num() > 0 && State != IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Starting && Now >= NextStepTime)
+	{
+		const FScriptStep Step = Script[0];
+		Script.RemoveAt(0);
+		EnterState(Step.State);
+	}
+
+	for (int32 Index = 0; Index < DelayedResponses.Num(); )
+	{
+		if (Now >= DelayedResponses[Index].DueTime)
+		{
+			FDelayedResponse DelayedResponse = MoveTemp(DelayedResponses[Index]);
+			DelayedResponses.RemoveAt(Index);
+			DelayedResponse.OnComplete(MoveTemp(DelayedResponse.Response));
+		}
+		else
+		{
+			++Index;
+		}
+	}
+
+	return true;
+}
+
+bool FShooterPayloadLocalApiMock::Respond(TUniquePtr<FHttpServerResponse> Response, const FHttpResultCallback& OnComplete)
+{
+	if (DropRate > 0.0f && FMath::FRand() < DropRate)
+	{
+		// The request is accepted but never answered, the client has to time out
+		return true;
+	}
+
+	if (ErrorRate > 0.0f && FMath::FRand() < ErrorRate)
+	{
+		IMSZeuzAPI::OpenAPIErrorResponseV0 Error;
+		Error.Message = TEXT("Injected error");
+		Error.RequestId = FGuid::NewGuid().ToString();
+
+		Response = FHttpServerResponse::Create(ToJson(Error), TEXT("application/json"));
+		Response->Code = static_cast<EHttpServerResponseCodes>(ErrorCode);
+	}
+
+	if (LatencyMs > 0.0f)
+	{
+		FDelayedResponse& DelayedResponse = DelayedResponses.AddDefaulted_GetRef();
+		DelayedResponse.DueTime = FPlatformTime::Seconds() + LatencyMs / 1000.0;
+		DelayedResponse.Response = MoveTemp(Response);
+		DelayedResponse.OnComplete = OnComplete;
+	}
+	else
+	{
+		OnComplete(MoveTemp(Response));
+	}
+
+	return true;
+}
+
+bool FShooterPayloadLocalApiMock::RespondJson(const FString& Json, const FHttpResultCallback& OnComplete)
+{
+	return Respond(FHttpServerResponse::Create(Json, TEXT("application/json")), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleGetPayload(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	IMSZeuzAPI::OpenAPIGetPayloadResponseV0 Payload;
+	Payload.Result.Id = PayloadId;
+	Payload.Result.ClusterId = TEXT("mock-cluster");
+	Payload.Result.AllocationId = TEXT("mock-allocation");
+	Payload.Result.Created = Created;
+	Payload.Result.Status.State.Value = State;
+	Payload.Result.Status.Address = TEXT("127.0.0.1");
+	if (LastReserved.GetTicks() > 0)
+	{
+		Payload.Result.Status.LastReserved = LastReserved;
+	}
+	Payload.Result.Metadata.Labels = Labels;
+	Payload.Result.Metadata.Annotations = Annotations;
+
+	return RespondJson(ToJson(Payload), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleReady(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	if (State == IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Starting)
+	{
+		EnterState(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Ready);
+	}
+
+	return RespondJson(TEXT("{}"), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleSetMetadata(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, TMap<FString, FString>& Metadata)
+{
+	// Labels and annotations share the same key/value request body
+	const TSharedPtr<FJsonValue> JsonValue = ParseBody(Request);
+	IMSZeuzAPI::OpenAPISetAnnotationRequestV0 Body;
+	if (!JsonValue.IsValid() || !Body.FromJson(JsonValue))
+	{
+		return Respond(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest), OnComplete);
+	}
+
+	Metadata.Add(Body.Key, Body.Value);
+	return RespondJson(TEXT("{}"), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleGetSessionStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	int32 SizeHint = 0;
+	IMSZeuzAPI::JsonBodyWriter Writer(SizeHint);
+	IMSZeuzAPI::WriteJsonValue(Writer.GetWriter(), SessionStatus);
+
+	return RespondJson(Writer.ToString(), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleSetSessionStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	const TSharedPtr<FJsonValue> JsonValue = ParseBody(Request);
+	TMap<FString, FString> NewStatus;
+	if (!JsonValue.IsValid() || !IMSZeuzAPI::TryGetJsonValue(JsonValue, NewStatus))
+	{
+		return Respond(FHttpServerResponse::Error(EHttpServerResponseCodes::BadRequest), OnComplete);
+	}
+
+	SessionStatus = MoveTemp(NewStatus);
+	return RespondJson(TEXT("{}"), OnComplete);
+}
+
+bool FShooterPayloadLocalApiMock::HandleGetSessionConfig(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	IMSZeuzAPI::OpenAPISessionConfigV0 Config;
+	if (!SessionConfig.IsEmpty())
+	{
+		Config.Config = SessionConfig;
+	}
+
+	return RespondJson(ToJson(Config), OnComplete);
+}
+
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
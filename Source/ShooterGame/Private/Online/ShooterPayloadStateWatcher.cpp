@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterPayloadStateWatcher.h"
+#include "Online/ShooterIMSClient.h"
+
+FShooterPayloadStateWatcher::FShooterPayloadStateWatcher(const TSharedRef<FShooterIMSClient>& InIMSClient, const FShooterPayloadPollSchedule& InSchedule)
+	: IMSClient(InIMSClient)
+	, Schedule(InSchedule)
+	, State(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values::Unknown)
+	, CurrentInterval(InSchedule.MinInterval)
+	, NextPollTime(0.0)
+	, bPollInFlight(false)
+	, bPollRequested(false)
+{
+}
+
+void FShooterPayloadStateWatcher::PollNow()
+{
+	CurrentInterval = Schedule.MinInterval;
+	NextPollTime = FPlatformTime::Seconds();
+
+	// The response of a request already in flight may predate the event, poll again once it completes
+	bPollRequested = bPollInFlight;
+}
+
+bool FShooterPayloadStateWatcher::Tick(float DeltaTime)
+{
+	if (!bPollInFlight && FPlatformTime::Seconds() >= NextPollTime)
+	{
+		Poll();
+	}
+
+	return true;
+}
+
+void FShooterPayloadStateWatcher::Poll()
+{
+	// Requests are not retried, a failed poll is simply followed by another one after MinInterval
+	IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Request Request;
+
+	bPollInFlight = true;
+	IMSClient->GetPayloadV0(Request, IMSZeuzAPI::OpenAPIPayloadLocalApi::FGetPayloadV0Delegate::CreateSP(this, &FShooterPayloadStateWatcher::OnPollComplete));
+}
+
+void FShooterPayloadStateWatcher::OnPollComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Response& Response)
+{
+	bPollInFlight = false;
+
+	if (Response.IsSuccessful())
+	{
+		const IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values PendingState = Response.Content.Result.Status.State.Value;
+		if (State != PendingState)
+		{
+			const IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values OldState = State;
+			State = PendingState;
+			CurrentInterval = Schedule.MinInterval;
+
+			UE_LOG(LogGameMode, Verbose, TEXT("Payload state changed from %s to %s."), *IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumToString(OldState), *IMSZeuzAPI::OpenAPIPayloadStatusStateV0::EnumToString(State));
+			StateChangedEvent.Broadcast(OldState, State);
+		}
+		else
+		{
+			CurrentInterval = FMath::Min(CurrentInterval * Schedule.BackoffMultiplier, GetMaxInterval(State));
+		}
+	}
+	else
+	{
+		UE_LOG(LogGameMode, Display, TEXT("Failed to retrieve payload details."));
+		CurrentInterval = Schedule.MinInterval;
+	}
+
+	NextPollTime = FPlatformTime::Seconds() + (bPollRequested ? 0.0 : CurrentInterval);
+	bPollRequested = false;
+}
+
+float FShooterPayloadStateWatcher::GetMaxInterval(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values InState) const
+{
+	const float* MaxInterval = Schedule.MaxIntervals.Find(InState);
+	return MaxInterval ? FMath::Max(*MaxInterval, Schedule.MinInterval) : Schedule.MinInterval;
+}
@@ -0,0 +1,370 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterQosProber.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Common/UdpSocketReceiver.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+
+TUniquePtr<FShooterQosEchoServer> FShooterQosEchoServer::Instance;
+
+namespace
+{
+	/** How long the receiver threads wait for a datagram before checking whether they are stopped */
+	const FTimespan ReceiverWaitTime = FTimespan::FromMilliseconds(100);
+
+	/** Probes are the nonce of the prober, the index of the target and the index of the sample, little endian */
+	void WriteUInt32(uint8* Data, uint32 Value)
+	{
+		Data[0] = static_cast<uint8>(Value);
+		Data[1] = static_cast<uint8>(Value >> 8);
+		Data[2] = static_cast<uint8>(Value >> 16);
+		Data[3] = static_cast<uint8>(Value >> 24);
+	}
+
+	uint32 ReadUInt32(const uint8* Data)
+	{
+		return static_cast<uint32>(Data[0]) | (static_cast<uint32>(Data[1]) << 8) | (static_cast<uint32>(Data[2]) << 16) | (static_cast<uint32>(Data[3]) << 24);
+	}
+
+	void DestroySocket(FSocket*& Socket)
+	{
+		if (Socket != nullptr)
+		{
+			Socket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+			Socket = nullptr;
+		}
+	}
+}
+
+FShooterQosProber::FShooterQosProber(int32 InNumSamples, float InSampleIntervalSeconds, float InTimeoutSeconds)
+	: NumSamples(FMath::Max(InNumSamples, 1))
+	, SampleIntervalSeconds(FMath::Max(InSampleIntervalSeconds, 0.0f))
+	, TimeoutSeconds(FMath::Max(InTimeoutSeconds, 0.0f))
+	, Nonce(FGuid::NewGuid().A)
+	, Socket(nullptr)
+	, StartTime(0.0)
+	, NumSamplesSent(0)
+	, bStarted(false)
+	, bFinished(false)
+{
+}
+
+FShooterQosProber::~FShooterQosProber()
+{
+	CloseSocket();
+}
+
+int32 FShooterQosProber::AddTarget(const FString& Address, int32 Port)
+{
+	check(!bStarted);
+
+	FTarget& Target = Targets.AddDefaulted_GetRef();
+	FIPv4Address IPAddress;
+	Target.bValid = Port > 0 && Port <= MAX_uint16 && FIPv4Address::Parse(Address, IPAddress);
+	Target.Endpoint = FIPv4Endpoint(IPAddress, static_cast<uint16>(Port));
+	Target.SendTimes.Init(0.0, NumSamples);
+	Target.RoundTrips.Init(-1.0, NumSamples);
+
+	return Targets.Num() - 1;
+}
+
+void FShooterQosProber::Start(TFunction<void(const TArray<FShooterQosResult>&)>&& InOnComplete)
+{
+	check(!bStarted);
+
+	OnComplete = MoveTemp(InOnComplete);
+	bStarted = true;
+	StartTime = FPlatformTime::Seconds();
+
+	Socket = FUdpSocketBuilder(TEXT("ShooterQosProber")).AsNonBlocking().Build();
+	if (Socket == nullptr)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("QoS prober: failed to create a UDP socket, sessions will be ranked without latency"));
+
+		// Finishes on the next tick, the results are all unreachable
+		for (FTarget& Target : Targets)
+		{
+			Target.bValid = false;
+		}
+		return;
+	}
+
+	Receiver = MakeUnique<FUdpSocketReceiver>(Socket, ReceiverWaitTime, TEXT("ShooterQosProber"));
+	Receiver->OnDataReceived().BindLambda([this](const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+	{
+		// Stamped before the game thread gets to the reply, which may be a frame later
+		const double ReceiveTime = FPlatformTime::Seconds();
+		if (Data->Num() == ProbeSize)
+		{
+			FReply Reply;
+			Reply.Sender = Sender;
+			Reply.ReceiveTime = ReceiveTime;
+			FMemory::Memcpy(Reply.Data, Data->GetData(), sizeof(Reply.Data));
+			Replies.Enqueue(Reply);
+		}
+	});
+	Receiver->Start();
+}
+
+void FShooterQosProber::Cancel()
+{
+	bFinished = true;
+	OnComplete.Reset();
+	CloseSocket();
+}
+
+bool FShooterQosProber::Tick(float DeltaTime)
+{
+	if (!bStarted || bFinished)
+	{
+		return true;
+	}
+
+	// The samples are spaced so that a burst of loss does not take them all, every target gets each sample at once
+	const double Now = FPlatformTime::Seconds();
+	while (Socket != nullptr && NumSamplesSent < NumSamples && Now >= StartTime + NumSamplesSent * SampleIntervalSeconds)
+	{
+		SendSample(NumSamplesSent++);
+	}
+
+	ProcessReplies();
+
+	const bool bTimedOut = Now >= StartTime + (NumSamples - 1) * SampleIntervalSeconds + TimeoutSeconds;
+	if (HasAllReplies() || bTimedOut)
+	{
+		Finish();
+	}
+
+	return true;
+}
+
+void FShooterQosProber::SendSample(int32 Sample)
+{
+	uint8 Probe[ProbeSize];
+	WriteUInt32(Probe, Nonce);
+	WriteUInt32(Probe + 8, static_cast<uint32>(Sample));
+
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		FTarget& Target = Targets[TargetIndex];
+		if (!Target.bValid)
+		{
+			continue;
+		}
+
+		WriteUInt32(Probe + 4, static_cast<uint32>(TargetIndex));
+
+		// The send time is recorded first, the reply may be received before SendTo returns
+		Target.SendTimes[Sample] = FPlatformTime::Seconds();
+
+		int32 BytesSent = 0;
+		Socket->SendTo(Probe, sizeof(Probe), BytesSent, *Target.Endpoint.ToInternetAddr());
+	}
+}
+
+void FShooterQosProber::ProcessReplies()
+{
+	FReply Reply;
+	while (Replies.Dequeue(Reply))
+	{
+		if (ReadUInt32(Reply.Data) != Nonce)
+		{
+			continue;
+		}
+
+		const uint32 TargetIndex = ReadUInt32(Reply.Data + 4);
+		const uint32 Sample = ReadUInt32(Reply.Data + 8);
+		if (TargetIndex >= static_cast<uint32>(Targets.Num()) || Sample >= static_cast<uint32>(NumSamplesSent))
+		{
+			continue;
+		}
+
+		// Replies from another address, or duplicated on the way, are not counted
+		FTarget& Target = Targets[TargetIndex];
+		if (!Target.bValid || Reply.Sender != Target.Endpoint || Target.RoundTrips[Sample] >= 0.0)
+		{
+			continue;
+		}
+
+		Target.RoundTrips[Sample] = FMath::Max(Reply.ReceiveTime - Target.SendTimes[Sample], 0.0);
+	}
+}
+
+bool FShooterQosProber::HasAllReplies() const
+{
+	for (const FTarget& Target : Targets)
+	{
+		if (Target.bValid && (NumSamplesSent < NumSamples || Target.RoundTrips.Contains(-1.0)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FShooterQosProber::CloseSocket()
+{
+	// The receiver thread is joined before its socket is destroyed
+	Receiver.Reset();
+	DestroySocket(Socket);
+}
+
+void FShooterQosProber::Finish()
+{
+	bFinished = true;
+	CloseSocket();
+
+	TArray<FShooterQosResult> Results;
+	Results.SetNum(Targets.Num());
+
+	TArray<double> RoundTrips;
+	for (int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex)
+	{
+		RoundTrips.Reset();
+		for (double RoundTrip : Targets[TargetIndex].RoundTrips)
+		{
+			if (RoundTrip >= 0.0)
+			{
+				RoundTrips.Add(RoundTrip);
+			}
+		}
+
+		FShooterQosResult& Result = Results[TargetIndex];
+		Result.PacketLoss = 1.0f - static_cast<float>(RoundTrips.Num()) / NumSamples;
+
+		// The median is not thrown off by a single sample delayed by a hitch on either side
+		if (RoundTrips.Num() > 0)
+		{
+			RoundTrips.Sort();
+			const int32 Middle = RoundTrips.Num() / 2;
+			const double Median = RoundTrips.Num() % 2 == 1 ? RoundTrips[Middle] : 0.5 * (RoundTrips[Middle - 1] + RoundTrips[Middle]);
+			Result.LatencyMs = static_cast<float>(Median * 1000.0);
+		}
+	}
+
+	// The callback may destroy the prober, nothing is accessed after it
+	TFunction<void(const TArray<FShooterQosResult>&)> Callback = MoveTemp(OnComplete);
+	if (Callback)
+	{
+		Callback(Results);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void FShooterQosEchoServer::Initialize()
+{
+	uint32 Port = 0;
+	if (!Instance.IsValid() && FParse::Value(FCommandLine::Get(), TEXT("QosEchoPort="), Port) && Port <= MAX_uint16)
+	{
+		float Latency = 0.0f;
+		float Drops = 0.0f;
+		FParse::Value(FCommandLine::Get(), TEXT("QosEchoLatencyMs="), Latency);
+		FParse::Value(FCommandLine::Get(), TEXT("QosEchoDropRate="), Drops);
+
+		Instance = MakeUnique<FShooterQosEchoServer>(static_cast<uint16>(Port), Latency, Drops);
+		Instance->RegisterConsoleCommands();
+	}
+}
+
+void FShooterQosEchoServer::Shutdown()
+{
+	Instance.Reset();
+}
+
+FShooterQosEchoServer::FShooterQosEchoServer(uint16 InPort, float InLatencyMs, float InDropRate)
+	: Port(InPort)
+	, Socket(nullptr)
+	, LatencyMs(0.0f)
+	, DropRate(0.0f)
+	, DropStream(FPlatformTime::Cycles())
+{
+	SetLatencyMs(InLatencyMs);
+	SetDropRate(InDropRate);
+
+	Socket = FUdpSocketBuilder(TEXT("ShooterQosEcho")).AsNonBlocking().AsReusable().BoundToPort(Port).Build();
+	if (Socket == nullptr)
+	{
+		UE_LOG(LogShooter, Error, TEXT("QoS echo server: failed to listen on UDP port %u"), Port);
+		return;
+	}
+
+	Port = static_cast<uint16>(Socket->GetPortNo());
+
+	Receiver = MakeUnique<FUdpSocketReceiver>(Socket, ReceiverWaitTime, TEXT("ShooterQosEcho"));
+	Receiver->OnDataReceived().BindRaw(this, &FShooterQosEchoServer::OnDataReceived);
+	Receiver->Start();
+
+	UE_LOG(LogShooter, Display, TEXT("QoS echo server listening on UDP port %u"), Port);
+}
+
+FShooterQosEchoServer::~FShooterQosEchoServer()
+{
+	for (IConsoleObject* ConsoleCommand : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleCommand);
+	}
+
+	Receiver.Reset();
+	DestroySocket(Socket);
+}
+
+void FShooterQosEchoServer::RegisterConsoleCommands()
+{
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.QosEcho.Latency"), TEXT("Sets the delay of the QoS echo replies in milliseconds"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SetLatencyMs(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f);
+		})));
+	ConsoleCommands.Add(ConsoleManager.RegisterConsoleCommand(TEXT("ims.QosEcho.Drops"), TEXT("Sets the ratio of QoS probes that are not answered"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([this](const TArray<FString>& Args)
+		{
+			SetDropRate(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.0f);
+		})));
+}
+
+void FShooterQosEchoServer::OnDataReceived(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender)
+{
+	// Only probes are answered, the server is not turned into a reflector of arbitrary datagrams
+	if (Data->Num() != FShooterQosProber::ProbeSize || DropStream.FRand() < DropRate)
+	{
+		return;
+	}
+
+	const float Latency = LatencyMs;
+	if (Latency > 0.0f)
+	{
+		FDelayedReply Reply;
+		Reply.DueTime = FPlatformTime::Seconds() + Latency / 1000.0;
+		Reply.Receiver = Sender;
+		Reply.Data = *Data;
+		DelayedReplies.Enqueue(MoveTemp(Reply));
+		return;
+	}
+
+	int32 BytesSent = 0;
+	Socket->SendTo(Data->GetData(), Data->Num(), BytesSent, *Sender.ToInternetAddr());
+}
+
+bool FShooterQosEchoServer::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	while (FDelayedReply* Reply = DelayedReplies.Peek())
+	{
+		if (Reply->DueTime > Now)
+		{
+			break;
+		}
+
+		int32 BytesSent = 0;
+		Socket->SendTo(Reply->Data.GetData(), Reply->Data.Num(), BytesSent, *Reply->Receiver.ToInternetAddr());
+		DelayedReplies.Pop();
+	}
+
+	return true;
+}
@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterServerDrain.h"
+
+FShooterServerDrain::FShooterServerDrain(const FText& InReason, float InDeadlineSeconds)
+	: Reason(InReason)
+	, DeadlineSeconds(InDeadlineSeconds)
+	, CurrentStep(0)
+	, bCurrentStepStarted(false)
+	, StepStartTime(0.0)
+	, StartTime(0.0)
+	, bStarted(false)
+	, bFinished(false)
+{
+}
+
+void FShooterServerDrain::AddStep(const TCHAR* Name, TFunction<void()>&& Begin, TFunction<bool()>&& IsComplete)
+{
+	check(!bStarted);
+
+	FStep& Step = Steps.AddDefaulted_GetRef();
+	Step.Name = Name;
+	Step.Begin = MoveTemp(Begin);
+	Step.IsComplete = MoveTemp(IsComplete);
+}
+
+void FShooterServerDrain::Start(TFunction<void(bool bTimedOut)>&& InOnComplete)
+{
+	check(!bStarted);
+
+	bStarted = true;
+	StartTime = FPlatformTime::Seconds();
+	OnComplete = MoveTemp(InOnComplete);
+
+	UE_LOG(LogGameMode, Display, TEXT("Draining server (%s): %d steps, deadline %.1fs"), *Reason.ToString(), Steps.Num(), DeadlineSeconds);
+
+	// Steps that complete right away should not cost a frame each
+	if (AdvanceSteps())
+	{
+		Finish(false);
+	}
+}
+
+bool FShooterServerDrain::Tick(float DeltaTime)
+{
+	if (!bStarted || bFinished)
+	{
+		return true;
+	}
+
+	if (AdvanceSteps())
+	{
+		Finish(false);
+	}
+	else if (FPlatformTime::Seconds() - StartTime >= DeadlineSeconds)
+	{
+		UE_LOG(LogGameMode, Warning, TEXT("Server drain deadline reached during step '%s'"), Steps[CurrentStep].Name);
+		Finish(true);
+	}
+
+	return true;
+}
+
+bool FShooterServerDrain::AdvanceSteps()
+{
+	while (CurrentStep < Steps.Num())
+	{
+		FStep& Step = Steps[CurrentStep];
+		if (!bCurrentStepStarted)
+		{
+			bCurrentStepStarted = true;
+			StepStartTime = FPlatformTime::Seconds();
+			if (Step.Begin)
+			{
+				Step.Begin();
+			}
+		}
+
+		if (Step.IsComplete && !Step.IsComplete())
+		{
+			return false;
+		}
+
+		UE_LOG(LogGameMode, Display, TEXT("Server drain step '%s' completed after %.3fs"), Step.Name, FPlatformTime::Seconds() - StepStartTime);
+		++CurrentStep;
+		bCurrentStepStarted = false;
+	}
+
+	return true;
+}
+
+void FShooterServerDrain::Finish(bool bTimedOut)
+{
+	bFinished = true;
+
+	UE_LOG(LogGameMode, Display, TEXT("Server drain %s after %.3fs"), bTimedOut ? TEXT("timed out") : TEXT("completed"), FPlatformTime::Seconds() - StartTime);
+
+	if (OnComplete)
+	{
+		OnComplete(bTimedOut);
+	}
+}
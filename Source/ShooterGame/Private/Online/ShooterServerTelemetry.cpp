@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterServerTelemetry.h"
+#include "Online/ShooterIMSClient.h"
+#include "Engine/NetDriver.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+	float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+	{
+		if (SortedValues.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+FShooterServerTelemetry::FShooterServerTelemetry(const TSharedRef<FShooterIMSClient>& InIMSClient, UWorld* InWorld, const FShooterServerTelemetrySettings& InSettings)
+	: IMSClient(InIMSClient)
+	, World(InWorld)
+	, Settings(InSettings)
+	, OutBytesPerSecondSum(0)
+	, NumOutBytesSamples(0)
+	, WindowStartTime(FPlatformTime::Seconds())
+	, NetTickStartTime(0.0)
+	, bAnnotationInFlight(false)
+	, bLabelInFlight(false)
+	, bFlushRequested(false)
+{
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FShooterServerTelemetry::OnWorldPostActorTick);
+	if (InWorld)
+	{
+		PostTickFlushHandle = InWorld->OnPostTickFlush().AddRaw(this, &FShooterServerTelemetry::OnPostTickFlush);
+	}
+}
+
+FShooterServerTelemetry::~FShooterServerTelemetry()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	if (World.IsValid())
+	{
+		World->OnPostTickFlush().Remove(PostTickFlushHandle);
+	}
+}
+
+void FShooterServerTelemetry::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == World.Get())
+	{
+		NetTickStartTime = FPlatformTime::Seconds();
+	}
+}
+
+void FShooterServerTelemetry::OnPostTickFlush(float DeltaSeconds)
+{
+	if (NetTickStartTime > 0.0)
+	{
+		NetTickTimesMs.Add(static_cast<float>((FPlatformTime::Seconds() - NetTickStartTime) * 1000.0));
+		NetTickStartTime = 0.0;
+	}
+
+	UNetDriver* NetDriver = World.IsValid() ? World->GetNetDriver() : nullptr;
+	if (NetDriver)
+	{
+		OutBytesPerSecondSum += NetDriver->OutBytesPerSecond;
+		++NumOutBytesSamples;
+	}
+}
+
+bool FShooterServerTelemetry::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ShooterServerTelemetry_Tick);
+
+	// Time spent waiting for the next frame because of the tick rate cap is not load
+	const double FrameTime = FApp::GetDeltaTime() - FApp::GetIdleTime();
+	FrameTimesMs.Add(static_cast<float>(FMath::Max(FrameTime, 0.0) * 1000.0));
+
+	if (bFlushRequested && !bAnnotationInFlight)
+	{
+		bFlushRequested = false;
+		CompleteWindow();
+	}
+	else if (FPlatformTime::Seconds() - WindowStartTime >= Settings.WindowSeconds)
+	{
+		CompleteWindow();
+	}
+
+	return true;
+}
+
+void FShooterServerTelemetry::CompleteWindow()
+{
+	FShooterServerTelemetrySnapshot Snapshot;
+
+	FrameTimesMs.Sort();
+	Snapshot.FrameTimeP50Ms = GetPercentile(FrameTimesMs, 0.50f);
+	Snapshot.FrameTimeP95Ms = GetPercentile(FrameTimesMs, 0.95f);
+	Snapshot.FrameTimeP99Ms = GetPercentile(FrameTimesMs, 0.99f);
+	Snapshot.FrameTimeMaxMs = FrameTimesMs.Num() > 0 ? FrameTimesMs.Last() : 0.0f;
+
+	float NetTickTimeSumMs = 0.0f;
+	for (float NetTickTimeMs : NetTickTimesMs)
+	{
+		NetTickTimeSumMs += NetTickTimeMs;
+		Snapshot.NetTickTimeMaxMs = FMath::Max(Snapshot.NetTickTimeMaxMs, NetTickTimeMs);
+	}
+	Snapshot.NetTickTimeAvgMs = NetTickTimesMs.Num() > 0 ? NetTickTimeSumMs / NetTickTimesMs.Num() : 0.0f;
+	Snapshot.OutBytesPerSecond = NumOutBytesSamples > 0 ? OutBytesPerSecondSum / NumOutBytesSamples : 0;
+
+	AGameStateBase* GameState = World.IsValid() ? World->GetGameState() : nullptr;
+	if (GameState)
+	{
+		for (APlayerState* PlayerState : GameState->PlayerArray)
+		{
+			if (PlayerState && PlayerState->IsABot())
+			{
+				++Snapshot.NumBots;
+			}
+			else if (PlayerState && !PlayerState->IsOnlyASpectator())
+			{
+				++Snapshot.NumPlayers;
+			}
+		}
+	}
+
+	Snapshot.UsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+
+	// Keep the allocations for the next window
+	FrameTimesMs.Reset();
+	NetTickTimesMs.Reset();
+	OutBytesPerSecondSum = 0;
+	NumOutBytesSamples = 0;
+	WindowStartTime = FPlatformTime::Seconds();
+
+	LastSnapshot = Snapshot;
+	Publish(Snapshot);
+}
+
+void FShooterServerTelemetry::Flush()
+{
+	bFlushRequested = true;
+}
+
+const TCHAR* FShooterServerTelemetry::GetLoadLabel(const FShooterServerTelemetrySnapshot& Snapshot, const FShooterServerTelemetrySettings& Settings)
+{
+	if (Snapshot.FrameTimeP95Ms >= Settings.LoadHighFrameTimeMs)
+	{
+		return TEXT("high");
+	}
+	else if (Snapshot.FrameTimeP95Ms >= Settings.LoadMidFrameTimeMs)
+	{
+		return TEXT("mid");
+	}
+
+	return TEXT("low");
+}
+
+void FShooterServerTelemetry::Publish(const FShooterServerTelemetrySnapshot& Snapshot)
+{
+	// Rate limited to one write per window, a window is skipped if the previous write has not completed yet
+	if (!bAnnotationInFlight)
+	{
+		FString Telemetry;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Telemetry);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("frame_ms_p50"), FMath::RoundToFloat(Snapshot.FrameTimeP50Ms * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("frame_ms_p95"), FMath::RoundToFloat(Snapshot.FrameTimeP95Ms * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("frame_ms_p99"), FMath::RoundToFloat(Snapshot.FrameTimeP99Ms * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("frame_ms_max"), FMath::RoundToFloat(Snapshot.FrameTimeMaxMs * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("net_tick_ms_avg"), FMath::RoundToFloat(Snapshot.NetTickTimeAvgMs * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("net_tick_ms_max"), FMath::RoundToFloat(Snapshot.NetTickTimeMaxMs * 100.0f) / 100.0f);
+		Writer->WriteValue(TEXT("out_bytes_per_sec"), static_cast<int64>(Snapshot.OutBytesPerSecond));
+		Writer->WriteValue(TEXT("players"), Snapshot.NumPlayers);
+		Writer->WriteValue(TEXT("bots"), Snapshot.NumBots);
+		Writer->WriteValue(TEXT("memory_mb"), static_cast<int64>(Snapshot.UsedPhysicalMemory / (1024 * 1024)));
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0Request Request;
+		Request.OpenAPISetAnnotationRequestV0.Emplace();
+		Request.OpenAPISetAnnotationRequestV0->Key = TEXT("telemetry");
+		Request.OpenAPISetAnnotationRequestV0->Value = Telemetry;
+
+		bAnnotationInFlight = true;
+		TWeakPtr<FShooterServerTelemetry> WeakThis = AsShared();
+		IMSClient->SetAnnotationV0(Request, IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetAnnotationV0Delegate::CreateLambda([WeakThis](const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0Response& Response)
+		{
+			if (TSharedPtr<FShooterServerTelemetry> This = WeakThis.Pin())
+			{
+				This->bAnnotationInFlight = false;
+			}
+		}));
+	}
+
+	const FString LoadLabel = GetLoadLabel(Snapshot, Settings);
+	if (!bLabelInFlight && LoadLabel != PublishedLoadLabel)
+	{
+		IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0Request Request;
+		Request.OpenAPISetLabelRequestV0.Emplace();
+		Request.OpenAPISetLabelRequestV0->Key = TEXT("load");
+		Request.OpenAPISetLabelRequestV0->Value = LoadLabel;
+
+		bLabelInFlight = true;
+		TWeakPtr<FShooterServerTelemetry> WeakThis = AsShared();
+		IMSClient->SetLabelV0(Request, IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetLabelV0Delegate::CreateLambda([WeakThis, LoadLabel](const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0Response& Response)
+		{
+			if (TSharedPtr<FShooterServerTelemetry> This = WeakThis.Pin())
+			{
+				This->bLabelInFlight = false;
+				if (Response.IsSuccessful())
+				{
+					This->PublishedLoadLabel = LoadLabel;
+				}
+			}
+		}));
+	}
+}
@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterServerWarmup.h"
+#include "Engine/AssetManager.h"
+#include "NavigationSystem.h"
+
+namespace
+{
+	/** How many levels of class references are followed from the classes added to the warmup */
+	const int32 MaxDependencyDepth = 3;
+}
+
+void FShooterStartupTimeline::Mark(const TCHAR* Milestone)
+{
+	for (const TPair<FString, double>& Existing : Milestones)
+	{
+		if (Existing.Key == Milestone)
+		{
+			return;
+		}
+	}
+
+	const double Time = FPlatformTime::Seconds() - GStartTime;
+	Milestones.Emplace(Milestone, Time);
+
+	UE_LOG(LogGameMode, Display, TEXT("Startup timeline: %s at %.3fs"), Milestone, Time);
+}
+
+void FShooterStartupTimeline::Log() const
+{
+	FString Timeline = TEXT("process start 0.000s");
+	double PreviousTime = 0.0;
+	for (const TPair<FString, double>& Milestone : Milestones)
+	{
+		Timeline += FString::Printf(TEXT(" -> %s %.3fs (+%.3fs)"), *Milestone.Key, Milestone.Value, Milestone.Value - PreviousTime);
+		PreviousTime = Milestone.Value;
+	}
+
+	UE_LOG(LogGameMode, Display, TEXT("Startup timeline: %s"), *Timeline);
+}
+
+FShooterServerWarmup::FShooterServerWarmup(UWorld* InWorld, float InDeadlineSeconds)
+	: World(InWorld)
+	, DeadlineSeconds(InDeadlineSeconds)
+	, StartTime(0.0)
+	, bStarted(false)
+	, bFinished(false)
+{
+}
+
+FShooterServerWarmup::~FShooterServerWarmup()
+{
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->CancelHandle();
+	}
+}
+
+void FShooterServerWarmup::AddClassDependencies(UClass* Class)
+{
+	if (Class != nullptr)
+	{
+		AddDependency(Class, 0);
+	}
+}
+
+void FShooterServerWarmup::AddDependency(UObject* Object, int32 Depth)
+{
+	if (Object == nullptr || VisitedObjects.Contains(Object))
+	{
+		return;
+	}
+	VisitedObjects.Add(Object);
+
+	// Only top level content assets need loading, native classes and subobjects come with their package
+	const bool bIsContentAsset = Object->GetOuter() != nullptr && Object->GetOuter()->IsA<UPackage>() && !Object->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn);
+	if (bIsContentAsset)
+	{
+		AssetsToLoad.AddUnique(FSoftObjectPath(Object));
+	}
+
+	if (Depth < MaxDependencyDepth)
+	{
+		UClass* Class = Cast<UClass>(Object);
+		AddObjectDependencies(Class ? Class->GetDefaultObject() : Object, Depth + 1);
+	}
+}
+
+void FShooterServerWarmup::AddSoftDependency(const FSoftObjectPath& AssetPath)
+{
+	// Soft references are usually not resident yet, these are the assets the warmup is for. They are loaded
+	// but not walked, their own references come with them once they are in memory.
+	if (AssetPath.IsValid())
+	{
+		AssetsToLoad.AddUnique(AssetPath);
+	}
+}
+
+void FShooterServerWarmup::AddObjectDependencies(UObject* Object, int32 Depth)
+{
+	if (Object == nullptr)
+	{
+		return;
+	}
+
+	for (TFieldIterator<FProperty> It(Object->GetClass()); It; ++It)
+	{
+		// Covers TSoftClassPtr too, FSoftClassProperty derives from FSoftObjectProperty
+		if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(*It))
+		{
+			for (int32 Index = 0; Index < SoftProperty->ArrayDim; ++Index)
+			{
+				AddSoftDependency(SoftProperty->GetPropertyValue_InContainer(Object, Index).ToSoftObjectPath());
+			}
+		}
+		else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(*It))
+		{
+			for (int32 Index = 0; Index < ObjectProperty->ArrayDim; ++Index)
+			{
+				AddDependency(ObjectProperty->GetObjectPropertyValue_InContainer(Object, Index), Depth);
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(*It))
+		{
+			FScriptArrayHelper_InContainer ArrayHelper(ArrayProperty, Object);
+			if (const FSoftObjectProperty* InnerSoftProperty = CastField<FSoftObjectProperty>(ArrayProperty->Inner))
+			{
+				for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+				{
+					AddSoftDependency(InnerSoftProperty->GetPropertyValue(ArrayHelper.GetRawPtr(Index)).ToSoftObjectPath());
+				}
+			}
+			else if (const FObjectPropertyBase* InnerProperty = CastField<FObjectPropertyBase>(ArrayProperty->Inner))
+			{
+				for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+				{
+					AddDependency(InnerProperty->GetObjectPropertyValue(ArrayHelper.GetRawPtr(Index)), Depth);
+				}
+			}
+		}
+	}
+}
+
+void FShooterServerWarmup::Start(TFunction<void(bool bTimedOut)>&& InOnComplete)
+{
+	check(!bStarted);
+
+	bStarted = true;
+	StartTime = FPlatformTime::Seconds();
+	OnComplete = MoveTemp(InOnComplete);
+
+	int32 NumNotResident = 0;
+	for (const FSoftObjectPath& AssetPath : AssetsToLoad)
+	{
+		if (AssetPath.ResolveObject() == nullptr)
+		{
+			++NumNotResident;
+		}
+	}
+
+	UE_LOG(LogGameMode, Display, TEXT("Warming up server: loading %d assets (%d not resident yet), deadline %.1fs"), AssetsToLoad.Num(), NumNotResident, DeadlineSeconds);
+
+	if (AssetsToLoad.Num() > 0)
+	{
+		LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+bool FShooterServerWarmup::Tick(float DeltaTime)
+{
+	if (!bStarted)
+	{
+		return true;
+	}
+
+	// Nothing left to watch once finished, stop ticking for the rest of the process
+	if (bFinished)
+	{
+		return false;
+	}
+
+	const bool bAssetsLoaded = !LoadHandle.IsValid() || LoadHandle->HasLoadCompleted() || LoadHandle->WasCanceled();
+	if (bAssetsLoaded && IsNavigationBuilt())
+	{
+		Finish(false);
+	}
+	else if (FPlatformTime::Seconds() - StartTime >= DeadlineSeconds)
+	{
+		UE_LOG(LogGameMode, Warning, TEXT("Server warmup deadline reached (assets loaded: %s, navigation built: %s)"),
+			bAssetsLoaded ? TEXT("true") : TEXT("false"), IsNavigationBuilt() ? TEXT("true") : TEXT("false"));
+		Finish(true);
+	}
+
+	return !bFinished;
+}
+
+bool FShooterServerWarmup::IsNavigationBuilt() const
+{
+	const UNavigationSystemV1* NavSys = World.IsValid() ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World.Get()) : nullptr;
+	return NavSys == nullptr || !NavSys->IsNavigationBuildInProgress();
+}
+
+void FShooterServerWarmup::Finish(bool bTimedOut)
+{
+	bFinished = true;
+
+	UE_LOG(LogGameMode, Display, TEXT("Server warmup %s after %.3fs"), bTimedOut ? TEXT("timed out") : TEXT("completed"), FPlatformTime::Seconds() - StartTime);
+
+	if (OnComplete)
+	{
+		OnComplete(bTimedOut);
+	}
+}
@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSessionConfig.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/BufferReader.h"
+
+namespace
+{
+	/** Describes one field of the session config, exactly one of IntField and StringField is set */
+	struct FSessionConfigField
+	{
+		const TCHAR* Name;
+		TOptional<int32> FShooterSessionConfig::* IntField;
+		TOptional<FString> FShooterSessionConfig::* StringField;
+		int32 Min;
+		int32 Max;
+	};
+
+	const FSessionConfigField SessionConfigFields[] =
+	{
+		{ TEXT("MaxNumPlayers"),	&FShooterSessionConfig::MaxNumPlayers,	nullptr,							AShooterGameMode::MIN_NUMBER_PLAYERS,	AShooterGameMode::MAX_NUMBER_PLAYERS },
+		{ TEXT("BotsCount"),		&FShooterSessionConfig::BotsCount,		nullptr,							AShooterGameMode::MIN_NUMBER_BOTS,		AShooterGameMode::MAX_NUMBER_BOTS },
+		{ TEXT("MapName"),			nullptr,								&FShooterSessionConfig::MapName,	0,										0 },
+		{ TEXT("GameMode"),			nullptr,								&FShooterSessionConfig::GameMode,	0,										0 },
+		{ TEXT("RoundTime"),		&FShooterSessionConfig::RoundTime,		nullptr,							30,										3600 },
+		{ TEXT("WarmupTime"),		&FShooterSessionConfig::WarmupTime,		nullptr,							0,										300 },
+	};
+
+	const FSessionConfigField* FindSessionConfigField(const FString& Name)
+	{
+		// Keys are matched case insensitively, like the FJsonObject fields they replace
+		for (const FSessionConfigField& Field : SessionConfigFields)
+		{
+			if (FCString::Stricmp(Field.Name, *Name) == 0)
+			{
+				return &Field;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool DecodeError(FString* OutError, const FString& Error)
+	{
+		if (OutError != nullptr)
+		{
+			*OutError = Error;
+		}
+
+		return false;
+	}
+}
+
+FString FShooterSessionConfig::Encode() const
+{
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	for (const FSessionConfigField& Field : SessionConfigFields)
+	{
+		if (Field.IntField != nullptr && (this->*Field.IntField).IsSet())
+		{
+			Writer->WriteValue(Field.Name, (this->*Field.IntField).GetValue());
+		}
+		else if (Field.StringField != nullptr && (this->*Field.StringField).IsSet())
+		{
+			Writer->WriteValue(Field.Name, (this->*Field.StringField).GetValue());
+		}
+	}
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Json;
+}
+
+bool FShooterSessionConfig::Decode(const FString& Json, TArray<FString>* OutUnknownKeys, FString* OutError)
+{
+	// Read the characters of the config in place rather than copying them into the reader
+	FBufferReader Archive(const_cast<TCHAR*>(*Json), Json.Len() * sizeof(TCHAR), false);
+	TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(&Archive);
+
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return DecodeError(OutError, TEXT("Session config is not a JSON object"));
+	}
+
+	while (Reader->ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			return true;
+		}
+
+		const FString& Key = Reader->GetIdentifier();
+		const FSessionConfigField* Field = FindSessionConfigField(Key);
+
+		if (Field == nullptr)
+		{
+			if (OutUnknownKeys != nullptr)
+			{
+				OutUnknownKeys->Add(Key);
+			}
+
+			// Nested values of unknown keys are skipped as a whole
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				Reader->SkipObject();
+			}
+			else if (Notation == EJsonNotation::ArrayStart)
+			{
+				Reader->SkipArray();
+			}
+		}
+		else if (Notation == EJsonNotation::Null)
+		{
+			// An explicit null leaves the field unchanged
+		}
+		else if (Field->IntField != nullptr)
+		{
+			if (Notation != EJsonNotation::Number)
+			{
+				return DecodeError(OutError, FString::Printf(TEXT("Session config field %s must be a number"), Field->Name));
+			}
+
+			const double Value = Reader->GetValueAsNumber();
+			const int32 ClampedValue = static_cast<int32>(FMath::RoundToDouble(FMath::Clamp(Value, static_cast<double>(Field->Min), static_cast<double>(Field->Max))));
+			if (ClampedValue != Value)
+			{
+				UE_LOG(LogShooter, Warning, TEXT("Session config field %s = %g clamped to %d"), Field->Name, Value, ClampedValue);
+			}
+
+			this->*Field->IntField = ClampedValue;
+		}
+		else
+		{
+			if (Notation != EJsonNotation::String)
+			{
+				return DecodeError(OutError, FString::Printf(TEXT("Session config field %s must be a string"), Field->Name));
+			}
+
+			this->*Field->StringField = Reader->GetValueAsString();
+		}
+	}
+
+	return DecodeError(OutError, Reader->GetErrorMessage().IsEmpty() ? FString(TEXT("Session config is not a complete JSON object")) : Reader->GetErrorMessage());
+}
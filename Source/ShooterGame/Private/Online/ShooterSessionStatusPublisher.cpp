@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterSessionStatusPublisher.h"
+#include "Online/ShooterIMSClient.h"
+
+FShooterSessionStatusPublisher::FShooterSessionStatusPublisher(const TSharedRef<FShooterIMSClient>& InIMSClient, float InCoalesceWindow, const IMSZeuzAPI::HttpRetryParams& InRetryPolicy)
+	: IMSClient(InIMSClient)
+	, CoalesceWindow(FMath::Max(InCoalesceWindow, 0.0f))
+	, RetryPolicy(InRetryPolicy)
+	, bDirty(false)
+	, bPublishInFlight(false)
+	, PublishTime(0.0)
+{
+}
+
+void FShooterSessionStatusPublisher::SetField(const FString& Key, const FString& Value)
+{
+	if (UpdateField(Key, Value))
+	{
+		MarkDirty();
+	}
+}
+
+void FShooterSessionStatusPublisher::SetFields(const TMap<FString, FString>& Fields)
+{
+	// All the changes of one call are a single update, it is merged at most once
+	bool bChanged = false;
+	for (const TPair<FString, FString>& Field : Fields)
+	{
+		bChanged |= UpdateField(Field.Key, Field.Value);
+	}
+
+	if (bChanged)
+	{
+		MarkDirty();
+	}
+}
+
+bool FShooterSessionStatusPublisher::UpdateField(const FString& Key, const FString& Value)
+{
+	const FString* CurrentValue = PendingStatus.Find(Key);
+	if (CurrentValue == nullptr || !CurrentValue->Equals(Value, ESearchCase::CaseSensitive))
+	{
+		PendingStatus.Add(Key, Value);
+		return true;
+	}
+
+	return false;
+}
+
+void FShooterSessionStatusPublisher::MarkDirty()
+{
+	if (bDirty)
+	{
+		++Stats.Merged;
+		return;
+	}
+
+	bDirty = true;
+	PublishTime = FPlatformTime::Seconds() + CoalesceWindow;
+}
+
+void FShooterSessionStatusPublisher::Flush()
+{
+	if (bDirty)
+	{
+		PublishTime = FPlatformTime::Seconds();
+		if (!bPublishInFlight)
+		{
+			Publish();
+		}
+	}
+}
+
+bool FShooterSessionStatusPublisher::Tick(float DeltaTime)
+{
+	if (bDirty && !bPublishInFlight && FPlatformTime::Seconds() >= PublishTime)
+	{
+		Publish();
+	}
+
+	return true;
+}
+
+void FShooterSessionStatusPublisher::Publish()
+{
+	bDirty = false;
+
+	if (PendingStatus.OrderIndependentCompareEqual(AcknowledgedStatus))
+	{
+		++Stats.Skipped;
+		return;
+	}
+
+	IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest Request;
+	Request.SetShouldRetry(RetryPolicy);
+	Request.RequestBody = PendingStatus;
+
+	InFlightStatus = PendingStatus;
+	bPublishInFlight = true;
+	++Stats.Sent;
+
+	UE_LOG(LogGameMode, Display, TEXT("Attempting to set session status..."));
+	IMSClient->ApiV0SessionManagerStatusPost(Request, IMSZeuzAPI::OpenAPISessionManagerLocalApi::FApiV0SessionManagerStatusPostDelegate::CreateSP(this, &FShooterSessionStatusPublisher::OnPublishComplete));
+}
+
+void FShooterSessionStatusPublisher::OnPublishComplete(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse& Response)
+{
+	bPublishInFlight = false;
+
+	if (Response.IsSuccessful())
+	{
+		UE_LOG(LogGameMode, Display, TEXT("Successfully set session status."));
+		AcknowledgedStatus = MoveTemp(InFlightStatus);
+	}
+	else
+	{
+		UE_LOG(LogGameMode, Display, TEXT("Failed to set session status."));
+		++Stats.Failed;
+
+		// Publish the latest status again after the coalesce window
+		if (!bDirty)
+		{
+			bDirty = true;
+			PublishTime = FPlatformTime::Seconds() + CoalesceWindow;
+		}
+	}
+
+	InFlightStatus.Reset();
+}
@@ -79,6 +79,18 @@ void AShooterPickup::PickupOnTouch(class AShooterCharacter* Pawn)
 	}
 }
 
+void AShooterPickup::SetRespawnTimerPaused(bool bPaused)
+{
+	if (bPaused)
+	{
+		GetWorldTimerManager().PauseTimer(TimerHandle_RespawnPickup);
+	}
+	else
+	{
+		GetWorldTimerManager().UnPauseTimer(TimerHandle_RespawnPickup);
+	}
+}
+
 void AShooterPickup::RespawnPickup()
 {
 	bIsActive = true;
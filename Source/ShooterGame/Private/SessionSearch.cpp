@@ -3,41 +3,200 @@
 #include "ShooterGame.h"
 #include "SessionSearch.h"
 
-Session::Session(IMSSessionManagerAPI::OpenAPIV0Session SessionResponse) : IMSSessionManagerAPI::OpenAPIV0Session(SessionResponse)
+namespace
 {
-	const IMSSessionManagerAPI::OpenAPIV0Port* GamePortResponse = Ports.FindByPredicate([](IMSSessionManagerAPI::OpenAPIV0Port Port) { return Port.Name == "GamePort"; });
+	const float LatencyBucketMs = 20.0f;
 
-	if (GamePortResponse != nullptr)
+	/** Lower is better: reachable sessions, then lossy ones, then the ones that did not answer */
+	uint64 GetReachabilityRank(const FSessionRecord& Result, float MaxPacketLoss)
 	{
-		SessionAddress = Address + ":" + FString::FromInt(GamePortResponse->Port);;
+		if (!Result.Qos.IsReachable())
+		{
+			return 2;
+		}
+		return Result.Qos.PacketLoss > MaxPacketLoss ? 1 : 0;
 	}
+
+	/** Lower is better: sessions with free slots waiting for or playing a match, then unknown phases, then the others */
+	uint64 GetJoinRank(const FSessionRecord& Result)
+	{
+		if (Result.GetFillRatio() >= 1.0f)
+		{
+			return 2;
+		}
+
+		if (Result.IsInJoinablePhase())
+		{
+			return 0;
+		}
+		return Result.GamePhase.IsNone() ? 1 : 2;
+	}
+
+	/**
+	 * Packs the ranking criteria into an integer, from the most significant bits: reachability and join rank on 2 bits
+	 * each, latency bucket on 16 bits, free ratio in 1/1024 steps on 11 bits, then latency in 10 us steps on 24 bits
+	 */
+	uint64 MakeRankKey(const FSessionRecord& Result, float MaxPacketLoss)
+	{
+		const bool bReachable = Result.Qos.IsReachable();
+		const uint64 LatencyBucket = bReachable ? FMath::Min(FMath::FloorToInt(Result.Qos.LatencyMs / LatencyBucketMs), 0xFFFF) : 0xFFFF;
+		const uint64 Latency = bReachable ? FMath::Min(FMath::RoundToInt(Result.Qos.LatencyMs * 100.0f), 0xFFFFFF) : 0xFFFFFF;
+
+		// Sessions that do not tell their fill ratio come after the empty ones
+		const float FillRatio = Result.GetFillRatio();
+		const uint64 FreeRatio = FillRatio >= 0.0f ? FMath::RoundToInt((1.0f - FMath::Min(FillRatio, 1.0f)) * 1024.0f) : 0x7FF;
+
+		return (GetReachabilityRank(Result, MaxPacketLoss) << 53) | (GetJoinRank(Result) << 51) | (LatencyBucket << 35) | (FreeRatio << 24) | Latency;
+	}
+
+	const FString UnknownValue(TEXT("Unknown"));
+
+	/** Parses a player count of the session status, negative when missing or not a number */
+	int32 ParsePlayerCount(const FString* Value)
+	{
+		int32 Count = -1;
+		if (Value == nullptr || !LexTryParseString(Count, **Value) || Count < 0)
+		{
+			return -1;
+		}
+		return Count;
+	}
+
+	FName ParseName(const FString* Value)
+	{
+		return Value != nullptr && !Value->IsEmpty() ? FName(**Value) : NAME_None;
+	}
+}
+
+FSessionRecord::FSessionRecord(const IMSSessionManagerAPI::OpenAPIV0Session& SessionResponse)
+	: Id(SessionResponse.Id)
+	, Address(SessionResponse.Address)
+{
+	int32 GamePort = 0;
+	for (const IMSSessionManagerAPI::OpenAPIV0Port& Port : SessionResponse.Ports)
+	{
+		if (Port.Name == TEXT("GamePort"))
+		{
+			GamePort = Port.Port;
+		}
+		else if (Port.Name == TEXT("QosPort"))
+		{
+			QosPort = Port.Port;
+		}
+	}
+
+	if (GamePort != 0)
+	{
+		SessionAddress = FString::Printf(TEXT("%s:%d"), *Address, GamePort);
+		QosPort = QosPort != 0 ? QosPort : GamePort;
+	}
+
+	const TMap<FString, FString>& SessionStatus = SessionResponse.SessionStatus;
+	GamePhase = ParseName(SessionStatus.Find(TEXT("GamePhase")));
+	MapName = ParseName(SessionStatus.Find(TEXT("MapName")));
+	CurrentNumPlayers = ParsePlayerCount(SessionStatus.Find(TEXT("CurrentNumPlayers")));
+	MaxNumPlayers = ParsePlayerCount(SessionStatus.Find(TEXT("MaxNumPlayers")));
+}
+
+bool FSessionRecord::IsInJoinablePhase() const
+{
+	return GamePhase == MatchState::WaitingToStart || GamePhase == MatchState::InProgress;
+}
+
+FString FSessionRecord::GetSessionAddress() const
+{
+	return SessionAddress.IsEmpty() ? UnknownValue : SessionAddress;
+}
+
+FString FSessionRecord::GetGamePhase() const
+{
+	return GamePhase.IsNone() ? UnknownValue : GamePhase.ToString();
 }
 
-Session::~Session()
+FString FSessionRecord::GetMapName() const
 {
+	return MapName.IsNone() ? UnknownValue : MapName.ToString();
 }
 
-const FString Session::GetSessionAddress() const
+FString FSessionRecord::GetPlayerCount() const
 {
-	return SessionAddress.IsEmpty() ? "Unknown" : SessionAddress;
+	return HasPlayerCount() ? FString::Printf(TEXT("%d/%d"), CurrentNumPlayers, MaxNumPlayers) : UnknownValue;
 }
 
-const FString Session::GetFromSessionStatus(FString Key) const
+FString FSessionRecord::GetLatency() const
 {
-	if (SessionStatus.Contains(Key))
+	if (!Qos.IsReachable())
 	{
-		return *SessionStatus.Find(Key);
+		return UnknownValue;
 	}
 
-	return "Unknown";
+	const int32 LatencyMs = FMath::RoundToInt(Qos.LatencyMs);
+	return Qos.PacketLoss > 0.0f ? FString::Printf(TEXT("%d ms (%d%% loss)"), LatencyMs, FMath::RoundToInt(Qos.PacketLoss * 100.0f)) : FString::Printf(TEXT("%d ms"), LatencyMs);
+}
+
+void SessionSearch::CompleteWithRankedResults()
+{
+	SearchResults = MoveTemp(PendingResults);
+	PendingResults.Reset();
+	RankSearchResults();
 }
 
-const FString Session::GetPlayerCount() const
+void SessionSearch::PublishRankedResults()
 {
-	if (SessionStatus.Contains("CurrentNumPlayers") && SessionStatus.Contains("MaxNumPlayers"))
+	SearchResults = PendingResults;
+	RankSearchResults();
+}
+
+void SessionSearch::RankSearchResults()
+{
+	for (FSessionRecord& Result : SearchResults)
+	{
+		Result.RankKey = MakeRankKey(Result, MaxPacketLoss);
+	}
+
+	SearchResults.StableSort([](const FSessionRecord& A, const FSessionRecord& B) { return A.RankKey < B.RankKey; });
+
+	if (SearchResults.Num() > MaxSearchResults)
+	{
+		SearchResults.SetNum(MaxSearchResults);
+	}
+
+	++ResultsRevision;
+}
+
+float SessionSearch::GetQuickJoinScore(const FSessionRecord& Result, FName PreferredMapName) const
+{
+	if (!Result.Qos.IsReachable() || Result.Qos.PacketLoss > MaxPacketLoss || Result.Qos.LatencyMs > MaxQuickJoinLatencyMs || Result.GetFreeSlots() <= 0 || !Result.IsInJoinablePhase())
+	{
+		return -1.0f;
+	}
+
+	const bool bWaitingToStart = Result.GamePhase == MatchState::WaitingToStart;
+	const bool bPreferredMap = !PreferredMapName.IsNone() && Result.MapName == PreferredMapName;
+
+	float Score = 4.0f * (1.0f - Result.Qos.LatencyMs / MaxQuickJoinLatencyMs);
+	Score += 2.0f * FMath::Max(Result.GetFillRatio(), 0.0f);
+	Score += bPreferredMap ? 1.0f : 0.0f;
+	Score += bWaitingToStart ? 0.5f : 0.0f;
+	return Score;
+}
+
+const FSessionRecord* SessionSearch::FindQuickJoinSession(const TArray<FSessionRecord>& Results, const FString& PreferredMapName) const
+{
+	// Names compare without case, a map no session was listed on is not added to the name table
+	const FName PreferredMap(*PreferredMapName, FNAME_Find);
+
+	const FSessionRecord* BestSession = nullptr;
+	float BestScore = 0.0f;
+	for (const FSessionRecord& Result : Results)
 	{
-		return *SessionStatus.Find("CurrentNumPlayers") + "/" + *SessionStatus.Find("MaxNumPlayers");
+		const float Score = GetQuickJoinScore(Result, PreferredMap);
+		if (Score >= 0.0f && (BestSession == nullptr || Score > BestScore))
+		{
+			BestSession = &Result;
+			BestScore = Score;
+		}
 	}
 
-	return "Unknown";
+	return BestSession;
 }
@@ -246,6 +246,20 @@ void UShooterGameInstance::OnPostLoadMap(UWorld*)
 	{
 		ShooterViewport->HideLoadingScreen();
 	}
+
+	// The map of the session joined by a quick join is loaded, the player is in game unless the travel failed
+	const double TimeToInGame = FPlatformTime::Seconds() - QuickJoinStartTime;
+	const bool bQuickJoinInGame = QuickJoinStartTime > 0.0 && CurrentState == ShooterGameInstanceState::Playing;
+	QuickJoinStartTime = 0.0;
+
+	if (bQuickJoinInGame)
+	{
+		QuickJoinTimeToInGame.Record(TimeToInGame);
+		CSV_CUSTOM_STAT(IMS, QuickJoinTimeToInGame, static_cast<float>(TimeToInGame * 1000.0), ECsvCustomStatOp::Set);
+
+		UE_LOG(LogOnlineGame, Display, TEXT("Quick join: in game after %.2fs (p50 %.2fs, p95 %.2fs over %llu quick joins)"),
+			TimeToInGame, QuickJoinTimeToInGame.GetPercentileSeconds(50.0), QuickJoinTimeToInGame.GetPercentileSeconds(95.0), QuickJoinTimeToInGame.GetCount());
+	}
 }
 
 void UShooterGameInstance::OnUserCanPlayInvite(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
@@ -1124,7 +1138,7 @@ void UShooterGameInstance::InternalTravelToSession(const FName& SessionName)
 }
 
 /** Initiates the session searching */
-bool UShooterGameInstance::FindSessions(ULocalPlayer* PlayerOwner)
+bool UShooterGameInstance::FindSessions(ULocalPlayer* PlayerOwner, bool bBackground)
 {
 	CheckPlayerIsLoggedIn();
 
@@ -1134,19 +1148,88 @@ bool UShooterGameInstance::FindSessions(ULocalPlayer* PlayerOwner)
 		GameSession->OnFindSessionsComplete().RemoveAll(this);
 		OnSearchSessionsCompleteDelegateHandle = GameSession->OnFindSessionsComplete().AddUObject(this, &UShooterGameInstance::OnSearchSessionsComplete);
 
-		GameSession->FindSessions(SessionTicket);
+		bBackgroundSessionSearch = bBackground;
+		GameSession->FindSessions(SessionTicket, bBackground);
+		return true;
+	}
+
+	return false;
+}
+
+bool UShooterGameInstance::QuickJoin(ULocalPlayer* PlayerOwner, const FString& PreferredMapName)
+{
+	CheckPlayerIsLoggedIn();
+
+	AShooterGameSession* const GameSession = GetGameSession();
+	if (GameSession && !SessionTicket.IsEmpty())
+	{
+		// The quick join search reports its own failures
+		GameSession->OnFindSessionsComplete().RemoveAll(this);
+		GameSession->OnQuickJoinComplete().RemoveAll(this);
+		OnQuickJoinCompleteDelegateHandle = GameSession->OnQuickJoinComplete().AddUObject(this, &UShooterGameInstance::OnQuickJoinComplete);
+
+		AddNetworkFailureHandlers();
+		QuickJoinStartTime = FPlatformTime::Seconds();
+
+		FShooterQuickJoinSettings Settings;
+		Settings.PreferredMapName = PreferredMapName;
+		GameSession->QuickJoin(SessionTicket, Settings);
 		return true;
 	}
 
 	return false;
 }
 
+void UShooterGameInstance::CancelQuickJoin()
+{
+	QuickJoinStartTime = 0.0;
+
+	AShooterGameSession* const GameSession = GetGameSession();
+	if (GameSession)
+	{
+		GameSession->OnQuickJoinComplete().Remove(OnQuickJoinCompleteDelegateHandle);
+		GameSession->CancelQuickJoin();
+	}
+
+	RemoveNetworkFailureHandlers();
+}
+
+/** Callback which is intended to be called upon the completion of a quick join */
+void UShooterGameInstance::OnQuickJoinComplete(bool bWasSuccessful)
+{
+	UE_LOG(LogOnlineGame, Display, TEXT("OnQuickJoinComplete successful: %s"), bWasSuccessful ? TEXT("true") : TEXT("false"));
+
+	AShooterGameSession* const GameSession = GetGameSession();
+	if (GameSession)
+	{
+		GameSession->OnQuickJoinComplete().Remove(OnQuickJoinCompleteDelegateHandle);
+	}
+
+	if (MainMenuUI.IsValid())
+	{
+		MainMenuUI->OnQuickJoinComplete(bWasSuccessful);
+	}
+
+	if (bWasSuccessful)
+	{
+		ShowLoadingScreen();
+		GotoState(ShooterGameInstanceState::Playing);
+	}
+	else
+	{
+		QuickJoinStartTime = 0.0;
+	}
+
+	RemoveNetworkFailureHandlers();
+}
+
 /** Callback which is intended to be called upon finding sessions */
 void UShooterGameInstance::OnSearchSessionsComplete(bool bWasSuccessful)
 {
 	UE_LOG(LogOnlineGame, Display, TEXT("OnSearchSessionsComplete successful: %s"), bWasSuccessful ? TEXT("true") : TEXT("false"));
 
-	if (!bWasSuccessful)
+	// A failed background refresh keeps the results already shown, the next refresh may succeed
+	if (!bWasSuccessful && !bBackgroundSessionSearch)
 	{
 		FText ReturnReason = NSLOCTEXT("NetworkErrors", "SearchSessionsFailed", "Could not search for sessions. Please try again.");
 		FText OKButton = NSLOCTEXT("DialogButtons", "OKAY", "OK");
@@ -1880,21 +1963,6 @@ void UShooterGameInstance::DisplayOnlinePrivilegeFailureDialogs(const FUniqueNet
 	}
 }
 
-FString UShooterGameInstance::GetQuickMatchUrl()
-{
-	static const FString QuickMatchUrl(TEXT("/Game/Maps/Highrise?game=TDM?listen"));
-	return QuickMatchUrl;
-}
-
-void UShooterGameInstance::BeginHostingQuickMatch()
-{
-	ShowLoadingScreen();
-	GotoState(ShooterGameInstanceState::Playing);
-
-	// Travel to the specified match URL
-	GetWorld()->ServerTravel(GetQuickMatchUrl());	
-}
-
 void UShooterGameInstance::PlayerPlayFabLogin()
 {
 	GetMutableDefault<UPlayFabRuntimeSettings>()->TitleId = PlayFabTitleId;
@@ -15,6 +15,8 @@
 
 
 #include "UI/Style/ShooterStyle.h"
+#include "Online/ShooterPayloadLocalApiMock.h"
+#include "Online/ShooterQosProber.h"
 
 
 class FShooterGameModule : public FDefaultGameModuleImpl
@@ -27,10 +29,19 @@ class FShooterGameModule : public FDefaultGameModuleImpl
 		//Hot reload hack
 		FSlateStyleRegistry::UnRegisterSlateStyle(FShooterStyle::GetStyleSetName());
 		FShooterStyle::Initialize();
+
+#if WITH_SHOOTER_PAYLOAD_MOCK
+		FShooterPayloadLocalApiMock::Initialize();
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
+		FShooterQosEchoServer::Initialize();
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FShooterQosEchoServer::Shutdown();
+#if WITH_SHOOTER_PAYLOAD_MOCK
+		FShooterPayloadLocalApiMock::Shutdown();
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
 		FShooterStyle::Shutdown();
 	}
 };
@@ -80,8 +80,6 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 
 	bShowingDownloadPct = false;
 	bAnimateQuickmatchSearchingUI = false;
-	bUsedInputToCancelQuickmatchSearch = false;
-	bQuickmatchSearchRequestCanceled = false;
 	bIncQuickMAlpha = false;
 	PlayerOwner = _PlayerOwner;
 	MatchType = EMatchType::Custom;
@@ -91,8 +89,6 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 	GameInstance = _GameInstance;
 	PlayerOwner = _PlayerOwner;
 
-	OnCancelMatchmakingCompleteDelegate = FOnCancelMatchmakingCompleteDelegate::CreateSP(this, &FShooterMainMenu::OnCancelMatchmakingComplete);
-	
 	// read user settings
 #if SHOOTER_CONSOLE_UI
 	bIsLanMatch = FParse::Param(FCommandLine::Get(), TEXT("forcelan"));
@@ -201,17 +197,6 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 		SAssignNew(QuickMatchSearchingWidgetContainer, SWeakWidget)
 			.PossiblyNullContent(QuickMatchSearchingWidget);
 
-		FText StoppingOKButtonString = LOCTEXT("Stopping", "STOPPING...");
-		QuickMatchStoppingWidget = SNew(SShooterConfirmationDialog).PlayerOwner(PlayerOwner)			
-			.MessageText(Msg)
-			.ConfirmText(StoppingOKButtonString)
-			.CancelText(FText())
-			.OnConfirmClicked(FOnClicked())
-			.OnCancelClicked(FOnClicked());
-
-		SAssignNew(QuickMatchStoppingWidgetContainer, SWeakWidget)
-			.PossiblyNullContent(QuickMatchStoppingWidget);
-
 #if SHOOTER_XBOX_MENU
 		TSharedPtr<FShooterMenuItem> MenuItem;
 
@@ -422,7 +407,6 @@ void FShooterMainMenu::Tick(float DeltaSeconds)
 			}
 		}
 		QuickMatchSearchingWidget->SetColorAndOpacity(QuickMColor);
-		QuickMatchStoppingWidget->SetColorAndOpacity(QuickMColor);
 	}
 
 	IPlatformChunkInstall* ChunkInstaller = FPlatformMisc::GetPlatformChunkInstall();
@@ -510,7 +494,6 @@ void FShooterMainMenu::OnLoginCompleteQuickmatch(int32 LocalUserNum, bool bWasSu
 
 void FShooterMainMenu::OnQuickMatchSelected()
 {
-	bQuickmatchSearchRequestCanceled = false;
 #if SHOOTER_CONSOLE_UI
 	if ( !ValidatePlayerForOnlinePlay(GetPlayerOwner()) )
 	{
@@ -569,52 +552,36 @@ FReply FShooterMainMenu::OnConfirmGeneric()
 
 void FShooterMainMenu::BeginQuickMatchSearch()
 {
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetTickableGameObjectWorld());
-	if(!Sessions.IsValid())
+	if (!GameInstance.IsValid() || GetPlayerOwner() == nullptr)
 	{
-		UE_LOG(LogOnline, Warning, TEXT("Quick match is not supported: couldn't find online session interface."));
+		UE_LOG(LogOnline, Warning, TEXT("Quick match is not supported: no game instance or player owner."));
 		return;
 	}
 
-	if (GetPlayerOwnerControllerId() == -1)
+	DisplayQuickmatchSearchingUI();
+
+	// The sessions listed on the selected map are preferred, a session is created on it when none fits
+	if (!GameInstance->QuickJoin(GetPlayerOwner(), GetMapName()))
 	{
-		UE_LOG(LogOnline, Warning, TEXT("Quick match is not supported: Could not get controller id from player owner"));
-		return;
+		OnQuickJoinComplete(false);
 	}
+}
 
-	QuickMatchSearchSettings = MakeShared<FShooterOnlineSearchSettings>(false, true);
-	QuickMatchSearchSettings->QuerySettings.Set(SEARCH_MATCHMAKING_QUEUE, FString("TeamDeathmatch"), EOnlineComparisonOp::Equals);
-	QuickMatchSearchSettings->QuerySettings.Set(SEARCH_XBOX_LIVE_HOPPER_NAME, FString("TeamDeathmatch"), EOnlineComparisonOp::Equals);
-	QuickMatchSearchSettings->QuerySettings.Set(SEARCH_XBOX_LIVE_SESSION_TEMPLATE_NAME, FString("MatchSession"), EOnlineComparisonOp::Equals);
-	QuickMatchSearchSettings->TimeoutInSeconds = 120.0f;
-
-	FShooterOnlineSessionSettings SessionSettings(false, true, 8);
-	SessionSettings.Set(SETTING_GAMEMODE, FString("TDM"), EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_MATCHING_HOPPER, FString("TeamDeathmatch"), EOnlineDataAdvertisementType::DontAdvertise);
-	SessionSettings.Set(SETTING_MATCHING_TIMEOUT, 120.0f, EOnlineDataAdvertisementType::ViaOnlineService);
-	SessionSettings.Set(SETTING_SESSION_TEMPLATE_NAME, FString("GameSession"), EOnlineDataAdvertisementType::DontAdvertise);
-
-	TSharedRef<FOnlineSessionSearch> QuickMatchSearchSettingsRef = QuickMatchSearchSettings.ToSharedRef();
-	
-	DisplayQuickmatchSearchingUI();
-
-	// Perform matchmaking with all local players
-	TArray<FSessionMatchmakingUser> LocalPlayers;
-	for (auto It = GameInstance->GetLocalPlayerIterator(); It; ++It)
+void FShooterMainMenu::OnQuickJoinComplete(bool bWasSuccessful)
+{
+	if (!bAnimateQuickmatchSearchingUI)
 	{
-		FUniqueNetIdRepl PlayerId = (*It)->GetPreferredUniqueNetId();
-		if (PlayerId.IsValid())
-		{
-			FSessionMatchmakingUser LocalPlayer = {(*PlayerId).AsShared()};
-			LocalPlayers.Emplace(LocalPlayer);
-		}
+		// Cancelled by the player
+		return;
 	}
 
-	FOnStartMatchmakingComplete CompletionDelegate;
-	CompletionDelegate.BindSP(this, &FShooterMainMenu::OnMatchmakingComplete);
-	if (!Sessions->StartMatchmaking(LocalPlayers, NAME_GameSession, SessionSettings, QuickMatchSearchSettingsRef, CompletionDelegate))
+	bAnimateQuickmatchSearchingUI = false;
+	GEngine->GameViewport->RemoveViewportWidgetContent(QuickMatchSearchingWidgetContainer.ToSharedRef());
+
+	if (!bWasSuccessful)
 	{
-		OnMatchmakingComplete(NAME_GameSession, FOnlineError(false), FSessionMatchmakingResults());
+		UE_LOG(LogOnline, Warning, TEXT("Quick join was unsuccessful."));
+		DisplayQuickmatchFailureUI();
 	}
 }
 
@@ -851,34 +818,22 @@ void FShooterMainMenu::SplitScreenBackedOut()
 
 void FShooterMainMenu::HelperQuickMatchSearchingUICancel(bool bShouldRemoveSession)
 {
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetTickableGameObjectWorld());
-	if (bShouldRemoveSession && Sessions.IsValid())
+	// The quick join is cancelled right away, nothing was joined or created that would need to be removed
+	if (bShouldRemoveSession && GameInstance.IsValid())
 	{
-		if (PlayerOwner.IsValid() && PlayerOwner->GetPreferredUniqueNetId().IsValid())
-		{
-			UGameViewportClient* const GVC = GEngine->GameViewport;
-			GVC->RemoveViewportWidgetContent(QuickMatchSearchingWidgetContainer.ToSharedRef());
-			GVC->AddViewportWidgetContent(QuickMatchStoppingWidgetContainer.ToSharedRef());
-			FSlateApplication::Get().SetKeyboardFocus(QuickMatchStoppingWidgetContainer);
-			
-			OnCancelMatchmakingCompleteDelegateHandle = Sessions->AddOnCancelMatchmakingCompleteDelegate_Handle(OnCancelMatchmakingCompleteDelegate);
-			Sessions->CancelMatchmaking(*PlayerOwner->GetPreferredUniqueNetId(), NAME_GameSession);
-		}
-	}
-	else
-	{
-		UGameViewportClient* const GVC = GEngine->GameViewport;
-		GVC->RemoveViewportWidgetContent(QuickMatchSearchingWidgetContainer.ToSharedRef());
-		AddMenuToGameViewport();
-		FSlateApplication::Get().SetKeyboardFocus(MenuWidget);
+		GameInstance->CancelQuickJoin();
 	}
+
+	bAnimateQuickmatchSearchingUI = false;
+	UGameViewportClient* const GVC = GEngine->GameViewport;
+	GVC->RemoveViewportWidgetContent(QuickMatchSearchingWidgetContainer.ToSharedRef());
+	AddMenuToGameViewport();
+	FSlateApplication::Get().SetKeyboardFocus(MenuWidget);
 }
 
 FReply FShooterMainMenu::OnQuickMatchSearchingUICancel()
 {
 	HelperQuickMatchSearchingUICancel(true);
-	bUsedInputToCancelQuickmatchSearch = true;
-	bQuickmatchSearchRequestCanceled = true;
 	return FReply::Handled();
 }
 
@@ -910,96 +865,6 @@ void FShooterMainMenu::DisplayQuickmatchSearchingUI()
 	bAnimateQuickmatchSearchingUI = true;
 }
 
-void FShooterMainMenu::OnMatchmakingComplete(FName SessionName, const FOnlineError& ErrorDetails, const FSessionMatchmakingResults& Results)
-{
-	const bool bWasSuccessful = ErrorDetails.WasSuccessful();
-	IOnlineSessionPtr SessionInterface = Online::GetSessionInterface(GetTickableGameObjectWorld());
-	if (!SessionInterface.IsValid())
-	{
-		UE_LOG(LogOnline, Warning, TEXT("OnMatchmakingComplete: Couldn't find session interface."));
-		return;
-	}
-
-	if (bQuickmatchSearchRequestCanceled && bUsedInputToCancelQuickmatchSearch)
-	{
-		bQuickmatchSearchRequestCanceled = false;
-		// Clean up the session in case we get this event after canceling
-		if (bWasSuccessful)
-		{
-			if (PlayerOwner.IsValid() && PlayerOwner->GetPreferredUniqueNetId().IsValid())
-			{
-				SessionInterface->DestroySession(NAME_GameSession);
-			}
-		}
-		return;
-	}
-
-	if (bAnimateQuickmatchSearchingUI)
-	{
-		bAnimateQuickmatchSearchingUI = false;
-		HelperQuickMatchSearchingUICancel(false);
-		bUsedInputToCancelQuickmatchSearch = false;
-	}
-	else
-	{
-		return;
-	}
-
-	if (!bWasSuccessful)
-	{
-		UE_LOG(LogOnline, Warning, TEXT("Matchmaking was unsuccessful."));
-		DisplayQuickmatchFailureUI();
-		return;
-	}
-
-	UE_LOG(LogOnline, Log, TEXT("Matchmaking successful! Session name is %s."), *SessionName.ToString());
-
-	if (GetPlayerOwner() == NULL)
-	{
-		UE_LOG(LogOnline, Warning, TEXT("OnMatchmakingComplete: No owner."));
-		return;
-	}
-
-	FNamedOnlineSession* MatchmadeSession = SessionInterface->GetNamedSession(SessionName);
-
-	if (!MatchmadeSession)
-	{
-		UE_LOG(LogOnline, Warning, TEXT("OnMatchmakingComplete: No session."));
-		return;
-	}
-
-	if(!MatchmadeSession->OwningUserId.IsValid())
-	{
-		UE_LOG(LogOnline, Warning, TEXT("OnMatchmakingComplete: No session owner/host."));
-		return;
-	}
-
-	if (GEngine && GEngine->GameViewport)
-	{
-		GEngine->GameViewport->RemoveViewportWidgetContent(QuickMatchSearchingWidgetContainer.ToSharedRef());
-	}
-	bAnimateQuickmatchSearchingUI = false;
-
-	UE_LOG(LogOnline, Log, TEXT("OnMatchmakingComplete: Session host is %d."), *MatchmadeSession->OwningUserId->ToString());
-
-	if (ensure(GameInstance.IsValid()))
-	{
-		MenuWidget->LockControls(true);
-
-		IOnlineSubsystem* Subsystem = Online::GetSubsystem(GetTickableGameObjectWorld());
-		if (Subsystem != nullptr && Subsystem->IsLocalPlayer(*MatchmadeSession->OwningUserId))
-		{
-			// This console is the host, start the map.
-			GameInstance->BeginHostingQuickMatch();
-		}
-		else
-		{
-			// We are the client, join the host.
-			GameInstance->TravelToSession(SessionName);
-		}
-	}
-}
-
 FShooterMainMenu::EMap FShooterMainMenu::GetSelectedMap() const
 {
 	if (GameInstance.IsValid() && GameInstance->GetOnlineMode() != EOnlineMode::Offline && HostOnlineMapOption.IsValid())
@@ -1393,19 +1258,4 @@ FString FShooterMainMenu::GetMapName() const
 	return MapNames[(int)GetSelectedMap()];
 }
 
-void FShooterMainMenu::OnCancelMatchmakingComplete(FName SessionName, bool bWasSuccessful)
-{
-	IOnlineSessionPtr Sessions = Online::GetSessionInterface(GetTickableGameObjectWorld());
-	if (Sessions.IsValid())
-	{
-		Sessions->ClearOnCancelMatchmakingCompleteDelegate_Handle(OnCancelMatchmakingCompleteDelegateHandle);
-	}
-
-	bAnimateQuickmatchSearchingUI = false;
-	UGameViewportClient* const GVC = GEngine->GameViewport;
-	GVC->RemoveViewportWidgetContent(QuickMatchStoppingWidgetContainer.ToSharedRef());
-	AddMenuToGameViewport();
-	FSlateApplication::Get().SetKeyboardFocus(MenuWidget);
-}
-
 #undef LOCTEXT_NAMESPACE
@@ -43,6 +43,9 @@ public:
 	/** Returns the string name of the currently selected map */
 	FString GetMapName() const;
 
+	/** Removes the quick match searching UI once the quick join is over, shows the failure UI if it failed */
+	void OnQuickJoinComplete(bool bWasSuccessful);
+
 protected:
 
 	enum class EMap
@@ -113,9 +116,6 @@ protected:
 	/** Record demo option */
 	TSharedPtr<class FShooterMenuItem> RecordDemoItem;
 
-	/** Settings and storage for quickmatch searching */
-	TSharedPtr<FOnlineSessionSearch> QuickMatchSearchSettings;
-
 	/** Map selection widget */
 	TSharedPtr<FShooterMenuItem> HostOfflineMapOption;
 	TSharedPtr<FShooterMenuItem> HostOnlineMapOption;
@@ -169,8 +169,6 @@ protected:
 
 	FReply OnSplitScreenPlay();
 
-	void OnMatchmakingComplete(FName SessionName, const FOnlineError& ErrorDetails, const FSessionMatchmakingResults& Results);
-
 	/** bot count option changed callback */
 	void BotCountOptionChanged(TSharedPtr<FShooterMenuItem> MenuItem, int32 MultiOptionIndex);
 
@@ -231,7 +229,7 @@ protected:
 	/** Display the loading screen. */
 	void DisplayLoadingScreen();
 
-	/** Begins searching for a quick match (matchmaking) */
+	/** Begins searching for a quick match, see UShooterGameInstance::QuickJoin */
 	void BeginQuickMatchSearch();
 
 	/** Checks the ChunkInstaller to see if the selected map is ready for play */
@@ -267,9 +265,6 @@ protected:
 	// Generic confirmation handling (just hide the dialog)
 	FReply OnConfirmGeneric();	
 
-	/** Delegate function executed when the quick match async cancel operation is complete */
-	void OnCancelMatchmakingComplete(FName SessionName, bool bWasSuccessful);
-
 	/** Delegate function executed when login completes after constructing the menu */
 	void OnLoginCompleteConstruct(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
 
@@ -282,9 +277,6 @@ protected:
 	/** Delegate function executed when login completes before quickmatch is started */
 	void OnLoginCompleteQuickmatch(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
 
-	/** Delegate for canceling matchmaking */
-	FOnCancelMatchmakingCompleteDelegate OnCancelMatchmakingCompleteDelegate;
-
 	/** number of bots in game */
 	int32 BotsCountOpt;
 
@@ -311,12 +303,6 @@ protected:
 	/** Are we currently animating the Searching for a QuickMatch UI? */
 	bool bAnimateQuickmatchSearchingUI;
 
-	/** Was the search request for quickmatch canceled while searching? */
-	bool bQuickmatchSearchRequestCanceled;
-
-	/** Was input used to cancel the search request for quickmatch? */
-	bool bUsedInputToCancelQuickmatchSearch;
-
 	/** Dedicated server? */
 	bool bIsDedicatedServer;
 
@@ -335,18 +321,11 @@ protected:
 	/* used for managing the QuickMatchSearchingWidget */
 	TSharedPtr<class SWeakWidget> QuickMatchSearchingWidgetContainer;	
 
-	/* used for managing the QuickMatchStoppingWidget */
-	TSharedPtr<class SShooterConfirmationDialog> QuickMatchStoppingWidget;
-
-	/* used for displaying a message while we wait for quick match to stop searching */
-	TSharedPtr<SWeakWidget> QuickMatchStoppingWidgetContainer;
-
 	/** Handler for cancel confirmation confirmations on the quickmatch widgets */
 	FReply OnQuickMatchFailureUICancel();
 	void HelperQuickMatchSearchingUICancel(bool bShouldRemoveSession); //helper for removing QuickMatch Searching UI
 	FReply OnQuickMatchSearchingUICancel();
 
-	FDelegateHandle OnCancelMatchmakingCompleteDelegateHandle;
 	FDelegateHandle OnLoginCompleteConstructDelegateHandle;
 	FDelegateHandle OnLoginCompleteQuickmatchDelegateHandle;
 	FDelegateHandle OnLoginCompleteHostOnlineDelegateHandle;
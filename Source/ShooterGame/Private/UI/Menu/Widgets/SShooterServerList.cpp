@@ -10,15 +10,76 @@
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+float GShooterServerListRefreshSeconds = 5.0f;
+static FAutoConsoleVariableRef CVarShooterServerListRefreshSeconds(
+	TEXT("ims.ServerList.RefreshSeconds"),
+	GShooterServerListRefreshSeconds,
+	TEXT("Seconds between the background refreshes of the server list while it is shown.\n")
+	TEXT("0 disables them. Default is 5."),
+	ECVF_Default
+	);
+
+namespace
+{
+	template<typename ValueType>
+	bool UpdateShownValue(ValueType& ShownValue, const ValueType& Value, bool bForce)
+	{
+		if (bForce || ShownValue != Value)
+		{
+			ShownValue = Value;
+			return true;
+		}
+		return false;
+	}
+}
+
+void FServerEntry::Update(const FSessionRecord& Result)
+{
+	const bool bForce = !bUpdated;
+	bUpdated = true;
+
+	// The address of a session does not change, the id it is matched by is its own
+	if (bForce)
+	{
+		SessionAddress = FText::FromString(Result.GetSessionAddress());
+	}
+
+	if (UpdateShownValue(ShownGamePhase, Result.GamePhase, bForce))
+	{
+		GamePhase = FText::FromString(Result.GetGamePhase());
+	}
+
+	if (UpdateShownValue(ShownMapName, Result.MapName, bForce))
+	{
+		MapName = FText::FromString(Result.GetMapName());
+	}
+
+	const bool bPlayerCountChanged = UpdateShownValue(ShownCurrentNumPlayers, Result.CurrentNumPlayers, bForce);
+	if (UpdateShownValue(ShownMaxNumPlayers, Result.MaxNumPlayers, bForce) || bPlayerCountChanged)
+	{
+		PlayerCount = FText::FromString(Result.GetPlayerCount());
+	}
+
+	// Compared as shown, to the millisecond and percent
+	const int32 LatencyMs = Result.Qos.IsReachable() ? FMath::RoundToInt(Result.Qos.LatencyMs) : -1;
+	const bool bLatencyChanged = UpdateShownValue(ShownLatencyMs, LatencyMs, bForce);
+	if (UpdateShownValue(ShownPacketLossPercent, FMath::RoundToInt(Result.Qos.PacketLoss * 100.0f), bForce) || bLatencyChanged)
+	{
+		Latency = FText::FromString(Result.GetLatency());
+	}
+}
+
 void SShooterServerList::Construct(const FArguments& InArgs)
 {
 	PlayerOwner = InArgs._PlayerOwner;
 	OwnerWidget = InArgs._OwnerWidget;
 	MapFilterName = "Any";
 	bSearchingForServers = false;
+	bBackgroundSearch = false;
 	StatusText = FText::GetEmpty();
 	BoxWidth = 125;
 	LastSearchTime = 0.0f;
+	ShownResultsRevision = INDEX_NONE;
 	
 #if PLATFORM_SWITCH
 	MinTimeBetweenSearches = 6.0;
@@ -50,7 +111,8 @@ void SShooterServerList::Construct(const FArguments& InArgs)
 					+ SHeaderRow::Column("Address").FixedWidth(BoxWidth * 2).DefaultLabel(NSLOCTEXT("Address", "AddressColumn", "Address"))
 					+ SHeaderRow::Column("GamePhase").DefaultLabel(NSLOCTEXT("GamePhase", "GamePhaseColumn", "Game Phase"))
 					+ SHeaderRow::Column("MapName").DefaultLabel(NSLOCTEXT("MapName", "MapNameColumn", "Map Name"))
-					+ SHeaderRow::Column("PlayerCount").DefaultLabel(NSLOCTEXT("PlayerCount", "PlayerCountColumn", "Player Count")))
+					+ SHeaderRow::Column("PlayerCount").DefaultLabel(NSLOCTEXT("PlayerCount", "PlayerCountColumn", "Player Count"))
+					+ SHeaderRow::Column("Latency").DefaultLabel(NSLOCTEXT("Latency", "LatencyColumn", "Ping")))
 			]
 		]
 		+SVerticalBox::Slot()
@@ -97,34 +159,32 @@ void SShooterServerList::UpdateSearchStatus()
 		switch(SearchState)
 		{
 			case SearchState::InProgress:
-				StatusText = LOCTEXT("Searching","SEARCHING...");
+				if (!bBackgroundSearch)
+				{
+					StatusText = LOCTEXT("Searching","SEARCHING...");
+
+					// The sessions of the session types that answered are shown while the others are searched
+					if (ShooterSession->GetSearchResultsRevision() != ShownResultsRevision)
+					{
+						ShownResultsRevision = ShooterSession->GetSearchResultsRevision();
+						ApplySearchResults(ShooterSession->GetSearchResults(), true);
+					}
+				}
 				bFinishSearch = false;
 				break;
 
 			case SearchState::Done:
 				{
-					ServerList.Empty();
-					const TArray<Session>& SearchResults = ShooterSession->GetSearchResults();
+					const TArray<FSessionRecord>& SearchResults = ShooterSession->GetSearchResults();
 
 					if (SearchResults.Num() == 0)
 					{
 						StatusText = LOCTEXT("ServersRefresh", "PRESS SPACE TO REFRESH SERVER LIST");
 					}
 
-					for (int32 IdxResult = 0; IdxResult < SearchResults.Num(); ++IdxResult)
-					{
-						TSharedPtr<FServerEntry> NewServerEntry = MakeShareable(new FServerEntry());
-
-						const Session& Result = SearchResults[IdxResult];
-
-						NewServerEntry->GamePhase = Result.GetGamePhase();
-						NewServerEntry->SessionAddress = Result.GetSessionAddress();
-						NewServerEntry->PlayerCount = Result.GetPlayerCount();
-						NewServerEntry->MapName = Result.GetMapName();
-						NewServerEntry->SearchResultsIndex = IdxResult;
-
-						ServerList.Add(NewServerEntry);
-					}
+					// Rows do not move under the player during background refreshes, a search asked for ranks them again
+					ShownResultsRevision = ShooterSession->GetSearchResultsRevision();
+					ApplySearchResults(SearchResults, !bBackgroundSearch);
 				}
 				break;
 
@@ -144,6 +204,61 @@ void SShooterServerList::UpdateSearchStatus()
 	}
 }
 
+void SShooterServerList::ApplySearchResults(const TArray<FSessionRecord>& SearchResults, bool bReorder)
+{
+	TMap<FString, TSharedPtr<FServerEntry>> RemovedEntries;
+	RemovedEntries.Reserve(ServerList.Num());
+	for (const TSharedPtr<FServerEntry>& Entry : ServerList)
+	{
+		RemovedEntries.Add(Entry->Id, Entry);
+	}
+
+	TArray<TSharedPtr<FServerEntry>> RankedEntries;
+	TArray<int32> InsertedRanks;
+	RankedEntries.Reserve(SearchResults.Num());
+	for (const FSessionRecord& Result : SearchResults)
+	{
+		TSharedPtr<FServerEntry> Entry;
+		if (!RemovedEntries.RemoveAndCopyValue(Result.Id, Entry))
+		{
+			Entry = MakeShareable(new FServerEntry());
+			Entry->Id = Result.Id;
+			InsertedRanks.Add(RankedEntries.Num());
+		}
+
+		// The rows bind to the cells, they show the changes without being generated again
+		Entry->Update(Result);
+		RankedEntries.Add(Entry);
+	}
+
+	TArray<TSharedPtr<FServerEntry>> NewServerList;
+	if (bReorder)
+	{
+		NewServerList = MoveTemp(RankedEntries);
+	}
+	else
+	{
+		NewServerList.Reserve(RankedEntries.Num());
+		for (const TSharedPtr<FServerEntry>& Entry : ServerList)
+		{
+			if (!RemovedEntries.Contains(Entry->Id))
+			{
+				NewServerList.Add(Entry);
+			}
+		}
+
+		for (int32 Rank : InsertedRanks)
+		{
+			NewServerList.Insert(RankedEntries[Rank], FMath::Min(Rank, NewServerList.Num()));
+		}
+	}
+
+	if (NewServerList != ServerList)
+	{
+		ServerList = MoveTemp(NewServerList);
+		ServerListWidget->RequestListRefresh();
+	}
+}
 
 FText SShooterServerList::GetBottomText() const
 {
@@ -164,10 +279,19 @@ void SShooterServerList::Tick( const FGeometry& AllottedGeometry, const double I
 	{
 		UpdateSearchStatus();
 	}
+	else if (GShooterServerListRefreshSeconds > 0.0f && LastSearchTime > 0.0)
+	{
+		// The widget only ticks while shown, the list is kept live once it has been searched
+		const double RefreshSeconds = FMath::Max<double>(GShooterServerListRefreshSeconds, MinTimeBetweenSearches);
+		if (FApp::GetCurrentTime() - LastSearchTime >= RefreshSeconds)
+		{
+			BeginServerSearch(true);
+		}
+	}
 }
 
 /** Starts searching for servers */
-void SShooterServerList::BeginServerSearch()
+void SShooterServerList::BeginServerSearch(bool bBackground)
 {
 	double CurrentTime = FApp::GetCurrentTime();
 	if (CurrentTime - LastSearchTime < MinTimeBetweenSearches)
@@ -176,14 +300,15 @@ void SShooterServerList::BeginServerSearch()
 	}
 	else
 	{
+		// The rows are kept, they are diffed against the results once the search completes
 		bSearchingForServers = true;
-		ServerList.Empty();
+		bBackgroundSearch = bBackground;
 		LastSearchTime = CurrentTime;
 
 		UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
 		if (GI)
 		{
-			GI->FindSessions(PlayerOwner.Get());
+			GI->FindSessions(PlayerOwner.Get(), bBackground);
 		}
 	}
 }
@@ -211,15 +336,22 @@ void SShooterServerList::UpdateServerList()
 
 void SShooterServerList::ConnectToServer()
 {
-	if (bSearchingForServers)
+	if (bSearchingForServers && !bBackgroundSearch)
 	{
 		// unsafe
 		return;
 	}
 
-	if (SelectedItem.IsValid())
+	AShooterGameSession* ShooterSession = GetGameSession();
+	if (SelectedItem.IsValid() && ShooterSession)
 	{
-		int ServerToJoin = SelectedItem->SearchResultsIndex;
+		// The search results may have been refreshed since the rows were updated
+		const FString& SelectedId = SelectedItem->Id;
+		int ServerToJoin = ShooterSession->GetSearchResults().IndexOfByPredicate([&SelectedId](const FSessionRecord& Result) { return Result.Id == SelectedId; });
+		if (ServerToJoin == INDEX_NONE)
+		{
+			return;
+		}
 
 		if (GEngine && GEngine->GameViewport)
 		{
@@ -271,7 +403,7 @@ void SShooterServerList::MoveSelection(int32 MoveBy)
 
 FReply SShooterServerList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) 
 {
-	if (bSearchingForServers) // lock input
+	if (bSearchingForServers && !bBackgroundSearch) // lock input
 	{
 		return FReply::Handled();
 	}
@@ -319,28 +451,40 @@ TSharedRef<ITableRow> SShooterServerList::MakeListViewWidget(TSharedPtr<FServerE
 
 		TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName)
 		{
-			FText ItemText = FText::GetEmpty();
+			FText FServerEntry::* Cell = nullptr;
 
 			if (ColumnName == "Address")
 			{
-				ItemText = FText::FromString(Item->SessionAddress);
+				Cell = &FServerEntry::SessionAddress;
 			}
 			else if (ColumnName == "GamePhase")
 			{
-				ItemText = FText::FromString(Item->GamePhase);
+				Cell = &FServerEntry::GamePhase;
 			}
 			else if (ColumnName == "MapName")
 			{
-				ItemText = FText::FromString(Item->MapName);
+				Cell = &FServerEntry::MapName;
 			}
 			else if (ColumnName == "PlayerCount")
 			{
-				ItemText = FText::FromString(Item->PlayerCount);
+				Cell = &FServerEntry::PlayerCount;
 			}
+			else if (ColumnName == "Latency")
+			{
+				Cell = &FServerEntry::Latency;
+			}
+
+			// Bound rather than copied, so that the entries updated by the refreshes show in the same widgets
 			return SNew(STextBlock)
-				.Text(ItemText)
+				.Text(this, &SServerEntryWidget::GetCellText, Cell)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuServerListTextStyle");
 		}
+
+		FText GetCellText(FText FServerEntry::* Cell) const
+		{
+			return Cell != nullptr ? (*Item).*Cell : FText::GetEmpty();
+		}
+
 		TSharedPtr<FServerEntry> Item;
 	};
 	return SNew(SServerEntryWidget, OwnerTable, Item);
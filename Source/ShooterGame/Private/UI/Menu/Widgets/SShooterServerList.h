@@ -10,13 +10,31 @@
 
 class AShooterGameSession;
 
+/** Row of the server list, kept across refreshes for as long as its session is found, see SShooterServerList::UpdateSearchStatus */
 struct FServerEntry
 {
-	FString SessionAddress;
-	FString GamePhase;
-	FString PlayerCount;
-	FString MapName;
-	int32 SearchResultsIndex;
+	/** Payload id of the session, rows are matched by it across refreshes */
+	FString Id;
+
+	/** Cells, converted to text once when they change rather than by the rows every frame */
+	FText SessionAddress;
+	FText GamePhase;
+	FText PlayerCount;
+	FText MapName;
+	FText Latency;
+
+	/** Updates the cells from a search result, only the ones that changed are converted */
+	void Update(const FSessionRecord& Result);
+
+private:
+	/** Values the cells were converted from, compared to the search result rather than the text of the cells */
+	bool bUpdated = false;
+	FName ShownGamePhase;
+	FName ShownMapName;
+	int32 ShownCurrentNumPlayers = 0;
+	int32 ShownMaxNumPlayers = 0;
+	int32 ShownLatencyMs = 0;
+	int32 ShownPacketLossPercent = 0;
 };
 
 //class declare
@@ -65,8 +83,8 @@ public:
 	/** Updates current search status */
 	void UpdateSearchStatus();
 
-	/** Starts searching for servers */
-	void BeginServerSearch();
+	/** Starts searching for servers, background searches refresh the list without locking it */
+	void BeginServerSearch(bool bBackground = false);
 
 	/** Called when server search is finished */
 	void OnServerSearchFinished();
@@ -74,6 +92,15 @@ public:
 	/** fill/update server list, should be called before showing this control */
 	void UpdateServerList();
 
+	/**
+	 * Applies the search results to the list: rows of the sessions still found are updated in place, rows of the
+	 * sessions gone are removed and rows of the new sessions are inserted, so that the list keeps its selection and
+	 * scroll position, and only generates widgets for the new rows.
+	 *
+	 * @param bReorder orders all the rows as ranked by the search, otherwise the rows already shown keep their order
+	 */
+	void ApplySearchResults(const TArray<FSessionRecord>& SearchResults, bool bReorder);
+
 	/** connect to chosen server */
 	void ConnectToServer();
 
@@ -94,9 +121,15 @@ protected:
 	/** Whether we're searching for servers */
 	bool bSearchingForServers;
 
+	/** Whether the search in progress is a background refresh, see GShooterServerListRefreshSeconds */
+	bool bBackgroundSearch;
+
 	/** Time the last search began */
 	double LastSearchTime;
 
+	/** Revision of the search results shown, see AShooterGameSession::GetSearchResultsRevision */
+	int32 ShownResultsRevision;
+
 	/** Minimum time between searches (platform dependent) */
 	double MinTimeBetweenSearches;
 
@@ -5,8 +5,12 @@
 #include "OnlineIdentityInterface.h"
 #include "ShooterPlayerController.h"
 #include "Json.h"
-#include "HttpModule.h"
-#include "HttpManager.h"
+#include "Online/ShooterIMSClient.h"
+#include "Online/ShooterPayloadStateWatcher.h"
+#include "Online/ShooterSessionStatusPublisher.h"
+#include "Online/ShooterServerWarmup.h"
+#include "Online/ShooterServerTelemetry.h"
+#include "Online/ShooterServerDrain.h"
 #include "OpenAPIPayloadLocalApi.h"
 #include "OpenAPIPayloadLocalApiOperations.h"
 #include "OpenAPISessionManagerLocalApi.h"
@@ -30,14 +34,28 @@ class AShooterGameMode : public AGameMode
 	UFUNCTION(exec)
 	void SetAllowBots(bool bInAllowBots, int32 InMaxBots = 8);
 
+	/** Logs the counters of the session status publisher */
+	UFUNCTION(exec)
+	void DumpSessionStatusStats();
+
+	/** Logs the time spent idle and active */
+	UFUNCTION(exec)
+	void DumpIdleStats();
+
 	virtual void PreInitializeComponents() override;
 
+	/** Cancels the IMS requests still in flight, their responses no longer matter */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Initialize the game. This is called before actors' PreInitializeComponents. */
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
 	/** Accept or reject a player attempting to join the server.  Fails login if you set the ErrorMessage to a non-empty string. */
 	virtual void PreLogin(const FString& Options, const FString& Address, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
 
+	/** Releases the pending login of a player whose login failed after PreLogin */
+	virtual APlayerController* Login(UPlayer* NewPlayer, ENetRole InRemoteRole, const FString& Portal, const FString& Options, const FUniqueNetIdRepl& UniqueId, FString& ErrorMessage) override;
+
 	/** starts match warmup */
 	virtual void PostLogin(APlayerController* NewPlayer) override;
 
@@ -127,6 +145,56 @@ protected:
 
 	UPROPERTY(config)
 	int32 TimeBeforeReservedPayloadTimeout;
+
+	/** interval at which the payload state is polled after a change, backing off while it stays the same */
+	UPROPERTY(config)
+	float PayloadStatePollMinInterval;
+
+	UPROPERTY(config)
+	float PayloadStatePollBackoffMultiplier;
+
+	/** longest interval at which the payload state is polled while Ready */
+	UPROPERTY(config)
+	float PayloadStatePollMaxIntervalReady;
+
+	/** longest interval at which the payload state is polled while Reserved */
+	UPROPERTY(config)
+	float PayloadStatePollMaxIntervalReserved;
+
+	/** longest interval at which the payload state is polled while Shutdown, Error or Unhealthy */
+	UPROPERTY(config)
+	float PayloadStatePollMaxIntervalTerminal;
+
+	/** time during which session status changes are merged before being published */
+	UPROPERTY(config)
+	float SessionStatusCoalesceWindow;
+
+	/** longest time the server warms up before the payload is set to Ready */
+	UPROPERTY(config)
+	float ServerWarmupDeadline;
+
+	/** server tick rate while the payload is Ready or Reserved with no players */
+	UPROPERTY(config)
+	int32 IdleNetServerMaxTickRate;
+
+	/** longest time an accepted login keeps the server out of idle mode before it reaches PostLogin */
+	UPROPERTY(config)
+	float PendingLoginTimeout;
+
+	/** window over which the server telemetry is aggregated before being written to the payload annotations */
+	UPROPERTY(config)
+	float TelemetryWindowSeconds;
+
+	/** 95th percentile frame time from which the payload load label is mid or high */
+	UPROPERTY(config)
+	float TelemetryLoadMidFrameTimeMs;
+
+	UPROPERTY(config)
+	float TelemetryLoadHighFrameTimeMs;
+
+	/** longest time the server drains before exiting */
+	UPROPERTY(config)
+	float DrainDeadline;
 	
 	/** Handle for efficient management of DefaultTimer timer */
 	FTimerHandle TimerHandle_DefaultTimer;
@@ -170,7 +238,7 @@ protected:
 	void SetupPayloadLocalAPI();
 
 	/* Called after retrieving Session Config */
-	void ProcessSessionConfig(FString SessionConfig);
+	void ProcessSessionConfig(const FString& SessionConfigJson);
 
 	/* Session Config parameters */
 	int32 MaxNumPlayers;
@@ -184,32 +252,61 @@ protected:
 	int RetryTimeoutRelativeSeconds;
 	IMSZeuzAPI::HttpRetryParams RetryPolicy;
 
-	/* IMS Zeuz APIs */
-	TSharedPtr<IMSZeuzAPI::OpenAPIPayloadLocalApi> PayloadLocalAPI;
-	TSharedPtr<IMSZeuzAPI::OpenAPISessionManagerLocalApi> SessionManagerLocalAPI;
+	/* IMS Zeuz APIs, requests are queued and issued from the core ticker, they never block the game thread */
+	TSharedPtr<FShooterIMSClient> IMSClient;
+
+	/* Idle mode, entered while the payload is Ready or Reserved with no players */
+	bool bIsIdle;
+	int32 ActiveNetServerMaxTickRate;
+	double TimeOfLastIdleModeChange;
+	double TotalIdleTime;
+	double TotalActiveTime;
+
+	/* Logins accepted by PreLogin that have not reached PostLogin yet, they keep the server out of idle mode */
+	int32 NumPendingLogins;
+	double TimeOfLastPreLogin;
+
+	/* Enters or exits idle mode depending on the payload state and the number of players */
+	void UpdateIdleMode();
+	bool ShouldBeIdle() const;
+	void ReleasePendingLogin();
+	void SetIdleMode(bool bNewIdle);
+
+	/* Publishes the server performance through the payload annotations and labels */
+	TSharedPtr<FShooterServerTelemetry> ServerTelemetry;
+
+	/* Warm up the server before setting the Payload to Ready */
+	TSharedPtr<FShooterServerWarmup> ServerWarmup;
+	void StartServerWarmup();
+
+	/* Startup milestones, from process start to Ready acknowledged */
+	FShooterStartupTimeline StartupTimeline;
 
 	/* Set the Payload to Ready when the GameServer is ready to accept connections */
 	IMSZeuzAPI::OpenAPIPayloadLocalApi::FReadyV0Delegate OnSetPayloadToReadyDelegate;
 	void OnSetPayloadToReadyComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Response& Response);
 	void TrySetPayloadToReady();
 
-	/* Retrieve details of the current payload, including metadata and status */
-	IMSZeuzAPI::OpenAPIPayloadLocalApi::FGetPayloadV0Delegate OnUpdatePayloadStatusDelegate;
-	void OnUpdatePayloadStatusComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Response& Response);
-	void UpdatePayloadStatus();
+	/* Watches the status of the current payload */
+	TSharedPtr<FShooterPayloadStateWatcher> PayloadStateWatcher;
+	void OnPayloadStateChanged(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values OldState, IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState);
 
 	/* Retrieve the Session Config that was set by the Game Client when creating the session */
 	IMSZeuzAPI::OpenAPISessionManagerLocalApi::FGetSessionConfigV0Delegate OnRetrieveSessionConfigDelegate;
 	void OnRetrieveSessionConfigComplete(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0Response& Response);
 	void RetrieveSessionConfig();
 
-	/* Set the Session Status */
-	IMSZeuzAPI::OpenAPISessionManagerLocalApi::FApiV0SessionManagerStatusPostDelegate OnSetSessionStatusDelegate;
-	void OnSetSessionStatusComplete(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse& Response);
+	/* Set the Session Status, changes are merged and published by the session status publisher */
+	TSharedPtr<FShooterSessionStatusPublisher> SessionStatusPublisher;
 	void SetSessionStatus();
 
 	/** Send all clients back to the main menu */
-	void ExitPlayersToMainMenu();
+	void ExitPlayersToMainMenu(const FText& Reason);
+
+	/* Drain the server before exiting: stop admitting players, notify them, flush the pending requests */
+	TSharedPtr<FShooterServerDrain> ServerDrain;
+	void BeginDrain(const FText& Reason);
+	bool IsDraining() const { return ServerDrain.IsValid(); }
 
 public:	
 
@@ -224,6 +321,13 @@ public:
 	/** get the name of the bots count option used in server travel URL */
 	static FString GetBotsCountOptionName();
 
+	/** Returns whether the server is idle, ticking at a low rate with bots and pickups paused */
+	bool IsIdle() const { return bIsIdle; }
+
+	/** Returns the time in seconds spent idle and active since the game mode was created */
+	double GetIdleTime() const;
+	double GetActiveTime() const;
+
 	UPROPERTY()
 	TArray<AShooterPickup*> LevelPickups;
 
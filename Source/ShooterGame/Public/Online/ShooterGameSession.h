@@ -10,6 +10,33 @@
 #include "SessionSearch.h"
 #include "ShooterGameSession.generated.h"
 
+/** Settings of a quick join, see AShooterGameSession::QuickJoin */
+struct FShooterQuickJoinSettings
+{
+	/** Map of the sessions joined in priority, any map when empty */
+	FString PreferredMapName;
+
+	/** Session created when none fits */
+	int32 MaxNumPlayers = 8;
+	int32 BotsCount = 0;
+
+	/** Time after which the quick join gives up searching, a session being created is waited for until its request deadline */
+	float BudgetSeconds = 20.0f;
+};
+
+/** Sessions of one session type searched, see AShooterGameSession::FindSessions */
+struct FShooterSessionSearchPool
+{
+	FString SessionType;
+
+	/** Whether the sessions are being listed or probed */
+	bool bPending = true;
+
+	/** Sessions listed, moved to the pending results of the search once probed */
+	TArray<FSessionRecord> Results;
+	TUniquePtr<FShooterQosProber> QosProber;
+};
+
 
 UCLASS(config=Game)
 class SHOOTERGAME_API AShooterGameSession : public AGameSession
@@ -24,6 +51,10 @@ protected:
 	UPROPERTY(config)
 	FString IMSSessionType;
 
+	/** Session types searched at once, regions or modes, only IMSSessionType is searched when empty */
+	UPROPERTY(config)
+	TArray<FString> IMSSearchSessionTypes;
+
 	/* Retry policy and configuration */
 	int RetryLimitCount = 5;
 	int RetryTimeoutRelativeSeconds = 10;
@@ -35,10 +66,28 @@ protected:
 	/* Session Manager Search */
 	TSharedPtr<class SessionSearch> CurrentSessionSearch;
 
+	/* Tokens of the requests in flight, replacing one cancels the previous request */
+	IMSOpenAPI::FCancellationTokenPtr HostSessionToken;
+	IMSOpenAPI::FCancellationTokenPtr FindSessionsToken;
+
+	/* Session types of the search in progress, listed and probed concurrently, replaced by each search */
+	TArray<FShooterSessionSearchPool> SearchPools;
+	TSet<FString> ListedSessionIds;
+	int32 NumListedPools = 0;
+	uint32 SearchSerial = 0;
+	bool bBackgroundSearch = false;
+	double FindSessionsStartTime = 0.0;
+	FTimerHandle FindSessionsTimerHandle;
+
+	/* Quick join in progress, see QuickJoin */
+	bool bQuickJoinInProgress = false;
+	bool bQuickJoinCreatingSession = false;
+	FShooterQuickJoinSettings QuickJoinSettings;
+	FString QuickJoinSessionTicket;
+	FTimerHandle QuickJoinTimerHandle;
+
 	/** Delegate for creating a new session */
 	IMSSessionManagerAPI::OpenAPISessionManagerV0Api::FCreateSessionV0Delegate OnCreateSessionCompleteDelegate;
-	/** Delegate for searching for sessions */
-	IMSSessionManagerAPI::OpenAPISessionManagerV0Api::FListSessionsV0Delegate OnFindSessionsCompleteDelegate;
 	/** Delegate after joining a session */
 	FOnJoinSessionCompleteDelegate OnJoinSessionCompleteDelegate;
 
@@ -48,17 +97,51 @@ protected:
 	// If SessionType is set when running the client in command line then use that, otherwise use hardcoded default from config
 	FString GetIMSSessionType();
 
+	// If SearchSessionTypes is set when running the client in command line (comma separated) then use that, otherwise use config
+	TArray<FString> GetIMSSearchSessionTypes();
+
 	/**
 	 * Delegate fired when a session create request has completed
 	 */
 	void OnCreateSessionComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::CreateSessionV0Response& Response);
 
 	/**
-	 * Delegate fired when a session search query has completed
+	 * Delegate fired when the sessions of one of the session types searched have been listed
+	 *
+	 * @param Serial search the request was issued by, responses to a previous search are ignored
+	 * @param PoolIndex session type the sessions were listed for, see SearchPools
+	 */
+	void OnFindSessionsComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Response& Response, uint32 Serial, int32 PoolIndex);
+
+	/**
+	 * Adds the sessions of a session type to the search once their latency has been probed
+	 */
+	void OnQosProbesComplete(const TArray<FShooterQosResult>& Results, uint32 Serial, int32 PoolIndex);
+
+	/** Publishes the sessions found so far while session types are pending, completes the search otherwise */
+	void OnSearchPoolComplete();
+
+	/** Completes the search with the session types that did answer once its deadline has passed */
+	void OnFindSessionsTimeout();
+
+	/** Ranks the sessions found, then completes the search */
+	void CompleteFindSessions();
+
+	/** Stops the search in progress, if any, without completing it */
+	void CancelFindSessions();
+
+	/**
+	 * Joins the best session found by the quick join search, or creates one when none fits
 	 *
-	 * @param bWasSuccessful true if the async action completed without error, false if there was an error
+	 * @param SessionAddress address of the session picked from the search, empty when none fits or the search failed
 	 */
-	void OnFindSessionsComplete(const IMSSessionManagerAPI::OpenAPISessionManagerV0Api::ListSessionsV0Response& Response);
+	void ContinueQuickJoin(const FString& SessionAddress);
+
+	/** Gives up on the quick join once its time budget is spent */
+	void OnQuickJoinTimeout();
+
+	/** Ends the quick join and broadcasts its result */
+	void FinishQuickJoin(bool bWasSuccessful);
 
 	/**
 	 * Create session config for create session request
@@ -86,8 +169,17 @@ protected:
 	DECLARE_EVENT_OneParam(AShooterGameSession, FOnFindSessionsComplete, bool /*bWasSuccessful*/);
 	FOnFindSessionsComplete FindSessionsCompleteEvent;
 
+	/*
+	 * Event triggered when a quick join has travelled to a session, or has given up
+	 */
+	DECLARE_EVENT_OneParam(AShooterGameSession, FOnQuickJoinComplete, bool /*bWasSuccessful*/);
+	FOnQuickJoinComplete QuickJoinCompleteEvent;
+
 public:
 
+	/** Cancels the session manager requests still in flight */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * Host a new online session
 	 *
@@ -100,12 +192,31 @@ public:
 	/**
 	 * Find an online session
 	 *
+	 * Every session type of GetIMSSearchSessionTypes is listed and probed concurrently. The sessions found are merged
+	 * and published as each type answers, unless in background, and the search completes once every type has answered
+	 * or RetryTimeoutRelativeSeconds have passed, with the types that did.
+	 *
 	 * @param UserId user that initiated the request
 	 * @param SessionName name of session this search will generate
 	 * @param bIsLAN are we searching LAN matches
 	 * @param bIsPresence are we searching presence sessions
+	 * @param bBackground refreshes the results of a previous search without waiting for the request
+	 */
+	void FindSessions(FString SessionTicket, bool bBackground = false);
+
+	/**
+	 * Finds sessions and travels to the best one to join, or creates a session and travels to it when none fits, as
+	 * a single operation. The search is bound by the time budget of the settings, the creation by its request deadline
+	 *
+	 * @param SessionTicket Ticket to authenticate the session manager requests
+	 * @param Settings Preferences and fallback of the quick join
 	 */
-	void FindSessions(FString SessionTicket);
+	void QuickJoin(FString SessionTicket, const FShooterQuickJoinSettings& Settings);
+
+	/** Cancels the quick join in progress, without broadcasting its completion */
+	void CancelQuickJoin();
+
+	bool IsQuickJoinInProgress() const { return bQuickJoinInProgress; }
 
 	/**
 	 * Joins one of the session in search results
@@ -126,7 +237,10 @@ public:
 	bool JoinSession(FString SessionAddress);
 
 	const SearchState GetSearchSessionsStatus() const;
-	const TArray<Session>& GetSearchResults() const;
+	const TArray<FSessionRecord>& GetSearchResults() const;
+
+	/** Changes whenever the search results are replaced, including by the partial results of a search in progress */
+	int32 GetSearchResultsRevision() const;
 
 	/** @return the delegate fired when creating a session */
 	FOnCreateSessionComplete& OnCreateSessionComplete() { return CreateSessionCompleteEvent; }
@@ -137,6 +251,9 @@ public:
 	/** @return the delegate fired when search of session completes */
 	FOnFindSessionsComplete& OnFindSessionsComplete() { return FindSessionsCompleteEvent; }
 
+	/** @return the delegate fired when a quick join completes */
+	FOnQuickJoinComplete& OnQuickJoinComplete() { return QuickJoinCompleteEvent; }
+
 	/**
 	 * Travel to a session address (as client) for a given session
 	 *
@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HttpRetrySystem.h"
+#include "OpenAPIPayloadLocalApi.h"
+#include "OpenAPIPayloadLocalApiOperations.h"
+#include "OpenAPISessionManagerLocalApi.h"
+#include "OpenAPISessionManagerLocalApiOperations.h"
+
+/**
+ * Client for the IMS zeuz Payload Local API and Session Manager Local API.
+ *
+ * Requests are queued through a lock-free queue and issued from the core ticker on the game thread, which is also where
+ * the HTTP manager ticks and completes them: the retry manager and the engine HTTP requests are not thread-safe, so the
+ * client never touches them from another thread. The bound delegates are executed from the same ticker, after the
+ * attempt has been handled, so they are never called back from within the HTTP manager.
+ *
+ * Each attempt is issued without engine retries. Failed attempts are retried following the policy of
+ * FShooterIMSTransport, within the retry limit and timeout of the request's retry params and its deadline.
+ * Requests cancelled with their token or with CancelAllRequests are dropped, their delegates are not executed. Any other
+ * request always completes: one the API refuses to issue completes with RequestTimeout past its deadline, Unknown otherwise.
+ */
+class FShooterIMSClient : public FTickerObjectBase
+{
+public:
+	FShooterIMSClient();
+	virtual ~FShooterIMSClient();
+
+	/** Sets the URL of the Payload Local API for both the payload and session manager endpoints */
+	void SetURL(const FString& Url);
+
+	/** Cancels every request issued so far, their delegates are not executed */
+	void CancelAllRequests();
+
+	/** Payload Local API */
+	void GetPayloadV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FGetPayloadV0Delegate& Delegate);
+	void ReadyV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::ReadyV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FReadyV0Delegate& Delegate);
+	void SetAnnotationV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetAnnotationV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetAnnotationV0Delegate& Delegate);
+	void SetLabelV0(const IMSZeuzAPI::OpenAPIPayloadLocalApi::SetLabelV0Request& Request, const IMSZeuzAPI::OpenAPIPayloadLocalApi::FSetLabelV0Delegate& Delegate);
+
+	/** Session Manager Local API */
+	void GetSessionConfigV0(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::GetSessionConfigV0Request& Request, const IMSZeuzAPI::OpenAPISessionManagerLocalApi::FGetSessionConfigV0Delegate& Delegate);
+	void ApiV0SessionManagerStatusPost(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostRequest& Request, const IMSZeuzAPI::OpenAPISessionManagerLocalApi::FApiV0SessionManagerStatusPostDelegate& Delegate);
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	/** Queues an operation of one of the APIs to be issued from the ticker */
+	template<typename ResponseType, typename ApiType, typename RequestType, typename DelegateType>
+	void QueueRequest(const TSharedRef<ApiType>& Api, FHttpRequestPtr (ApiType::*Operation)(const RequestType&, const DelegateType&) const, const RequestType& Request, const DelegateType& Delegate);
+
+	/** Progress of a request through its attempts */
+	struct FRetryState
+	{
+		int32 NumRetries = 0;
+		int32 MaxRetries = 0;
+		double Deadline = 0.0;
+		float RetryDelay = 0.0f;
+
+		/** Value of CancelCounter when the request was queued */
+		int32 CancelGeneration = 0;
+	};
+
+	/** Issues an attempt of a request, game thread only */
+	template<typename ResponseType, typename ApiType, typename RequestType, typename DelegateType>
+	void IssueRequest(const TSharedRef<ApiType>& Api, FHttpRequestPtr (ApiType::*Operation)(const RequestType&, const DelegateType&) const, const RequestType& Request, const DelegateType& Delegate, const FRetryState& RetryState);
+
+	/** Completes a request that was not issued with the given response code */
+	template<typename ResponseType, typename RequestType, typename DelegateType>
+	void CompleteRequest(const RequestType& Request, const DelegateType& Delegate, const FRetryState& RetryState, EHttpResponseCodes::Type ResponseCode);
+
+	/** Whether the request was cancelled with its token or by CancelAllRequests since it was queued */
+	bool IsCancelled(const IMSZeuzAPI::Request& Request, const FRetryState& RetryState) const;
+
+	/** Issues the queued requests and the retries that are due, then updates the retry manager, game thread only */
+	void ProcessRequests();
+
+	/** Executes the delegates of the completed requests, game thread only */
+	void ProcessResponses();
+
+	/** APIs, only accessed from the game thread */
+	TSharedRef<IMSZeuzAPI::OpenAPIPayloadLocalApi> PayloadLocalAPI;
+	TSharedRef<IMSZeuzAPI::OpenAPISessionManagerLocalApi> SessionManagerLocalAPI;
+
+	/** Retry manager shared by both APIs, updated from the ticker on the game thread where the HTTP manager completes its requests */
+	FHttpRetrySystem::FManager RetryManager;
+
+	/** Work to be executed from the ticker */
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> PendingRequests;
+
+	/** Attempts waiting for their retry delay, game thread only */
+	TArray<TPair<double, TUniqueFunction<void()>>> DelayedRequests;
+
+	/** Delegates of completed requests to be executed on the game thread */
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> CompletedResponses;
+
+	/** Incremented by CancelAllRequests */
+	FThreadSafeCounter CancelCounter;
+
+	/** Retry limits of the requests whose retry params do not override them */
+	static const int32 DefaultRetryLimitCount = 6;
+	static const int32 DefaultRetryTimeoutSeconds = 60;
+};
@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpResponse.h"
+
+/** Settings of the IMS transport */
+struct FShooterIMSTransportSettings
+{
+	/** Shortest and longest delay between two attempts of a request */
+	float BaseRetryDelay = 0.25f;
+	float MaxRetryDelay = 10.0f;
+
+	/** Retries allowed per second across all endpoints, and how many can be spent at once */
+	float RetryBudgetPerSecond = 2.0f;
+	float RetryBudgetBurst = 10.0f;
+
+	/** Consecutive failures after which an endpoint is considered down, and how long until it is tried again */
+	int32 BreakerFailureThreshold = 5;
+	float BreakerCooldownSeconds = 15.0f;
+};
+
+/** Counters of the IMS transport */
+struct FShooterIMSTransportStats
+{
+	/** Number of attempts issued, including retries */
+	uint32 Attempts = 0;
+
+	/** Number of retries issued */
+	uint32 Retries = 0;
+
+	/** Number of retries given up because the retry budget was spent */
+	uint32 RetriesOverBudget = 0;
+
+	/** Number of requests failed without being issued because the endpoint breaker was open */
+	uint32 RejectedByBreaker = 0;
+
+	/** Number of times an endpoint breaker opened */
+	uint32 BreakerTrips = 0;
+};
+
+/**
+ * Retry and circuit breaker policy shared by all the IMS API requests of the process.
+ *
+ * Retries are spaced with a decorrelated jitter exponential backoff, so that payloads failing at the same time do not
+ * retry in lockstep, and are limited by a process-wide budget. Each endpoint has a circuit breaker: after too many
+ * consecutive failures its requests fail right away until the cooldown has passed, then a single trial request is let
+ * through to decide whether it closes again. A trial whose result is not recorded within the cooldown is given up and
+ * another one is let through. Thread-safe.
+ */
+class FShooterIMSTransport
+{
+public:
+	static FShooterIMSTransport& Get();
+
+	FShooterIMSTransport();
+
+	void SetSettings(const FShooterIMSTransportSettings& InSettings);
+
+	/** Returns whether a request to the endpoint may be issued, false while its breaker is open. bOutTrial is set when the request is the trial of a half open breaker. */
+	bool AllowRequest(const FString& Endpoint, bool* bOutTrial = nullptr);
+
+	/** Records the outcome of a request to the endpoint */
+	void RecordResult(const FString& Endpoint, bool bEndpointAvailable);
+
+	/** Lets another trial through after the trial request to the endpoint ended without a result (not issued or cancelled) */
+	void ReleaseTrial(const FString& Endpoint);
+
+	/** Takes a retry from the budget, returns false if the budget is spent */
+	bool TryConsumeRetry();
+
+	/** Returns a random delay before the next attempt between BaseRetryDelay and three times the previous delay (pass zero for the first retry), capped at MaxRetryDelay */
+	float GetRetryDelay(float PreviousDelay) const;
+
+	/** Returns whether a response code means the request may succeed if retried */
+	static bool IsRetryableResponseCode(EHttpResponseCodes::Type ResponseCode);
+
+	FShooterIMSTransportStats GetStats() const;
+
+	/** Logs the counters and the state of the endpoint breakers */
+	void DumpStats() const;
+
+private:
+
+	enum class EBreakerState : uint8
+	{
+		Closed,
+		Open,
+		HalfOpen
+	};
+
+	struct FEndpointBreaker
+	{
+		EBreakerState State = EBreakerState::Closed;
+		int32 ConsecutiveFailures = 0;
+		double OpenUntil = 0.0;
+		bool bTrialInFlight = false;
+		double TrialStartTime = 0.0;
+	};
+
+	static const TCHAR* LexToString(EBreakerState State);
+
+	mutable FCriticalSection CriticalSection;
+
+	FShooterIMSTransportSettings Settings;
+	TMap<FString, FEndpointBreaker> Breakers;
+
+	/** Token bucket of retries */
+	float RetryBudget;
+	double LastRetryBudgetRefill;
+
+	FShooterIMSTransportStats Stats;
+};
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_SHOOTER_PAYLOAD_MOCK
+
+#include "Containers/Ticker.h"
+#include "HttpRouteHandle.h"
+#include "HttpResultCallback.h"
+#include "OpenAPIPayloadStatusStateV0.h"
+
+class IHttpRouter;
+class IConsoleObject;
+struct FHttpServerRequest;
+struct FHttpServerResponse;
+
+/**
+ * Stand-in for the Payload Local API, served in-process when the game is started with -zeuz-mock.
+ *
+ * It implements the payload and session manager endpoints used by the game server, so the IMS zeuz integration can be
+ * exercised without the orchestrator. After the payload is set to Ready, the state follows a script given with
+ * -ZeuzMockScript=<State>:<Seconds>,... where each step is entered the given number of seconds after the previous one,
+ * e.g. -ZeuzMockScript=Reserved:5,Shutdown:600. The orchestrator has no separate allocated state, a payload in a match
+ * stays Reserved.
+ *
+ * Faults can be injected with:
+ *  -ZeuzMockLatencyMs=<ms>      delay before every response
+ *  -ZeuzMockErrorRate=<0..1>    ratio of requests answered with -ZeuzMockErrorCode (500 by default)
+ *  -ZeuzMockDropRate=<0..1>     ratio of requests that are never answered
+ *
+ * The same settings can be changed at runtime with the ims.ZeuzMock.* console commands.
+ */
+class FShooterPayloadLocalApiMock : public FTickerObjectBase
+{
+public:
+	/** Starts the stand-in server if the game was started with -zeuz-mock */
+	static void Initialize();
+	static void Shutdown();
+
+	/** Returns whether the game was started with -zeuz-mock */
+	static bool IsEnabled();
+
+	/** Returns the running stand-in server, null when not enabled */
+	static FShooterPayloadLocalApiMock* Get() { return Instance.Get(); }
+
+	FShooterPayloadLocalApiMock(uint32 InPort);
+	virtual ~FShooterPayloadLocalApiMock();
+
+	/** Returns the URL to be given to the Payload Local API client */
+	FString GetURL() const;
+
+	/** Moves the payload to the given state, the remaining script steps are discarded */
+	void SetState(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState);
+
+	/** Sets the injected faults, the rates are clamped to [0, 1] and the latency to positive values */
+	void SetLatency(float InLatencyMs);
+	void SetErrorRate(float InErrorRate);
+	void SetDropRate(float InDropRate);
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	struct FScriptStep
+	{
+		IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values State;
+		float Delay;
+	};
+
+	struct FDelayedResponse
+	{
+		double DueTime;
+		TUniquePtr<FHttpServerResponse> Response;
+		FHttpResultCallback OnComplete;
+	};
+
+	/** Parses a script of the form <State>:<Seconds>,... */
+	static bool ParseScript(const FString& Script, TArray<FScriptStep>& OutSteps);
+
+	void BindRoutes();
+
+	/** Applies the injected faults and latency, then completes the request */
+	bool Respond(TUniquePtr<FHttpServerResponse> Response, const FHttpResultCallback& OnComplete);
+	bool RespondJson(const FString& Json, const FHttpResultCallback& OnComplete);
+
+	bool HandleGetPayload(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleReady(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleSetMetadata(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete, TMap<FString, FString>& Metadata);
+	bool HandleGetSessionStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleSetSessionStatus(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+	bool HandleGetSessionConfig(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
+	void EnterState(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values NewState);
+
+	static TUniquePtr<FShooterPayloadLocalApiMock> Instance;
+
+	uint32 Port;
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+	TArray<IConsoleObject*> ConsoleCommands;
+
+	/** Payload */
+	FString PayloadId;
+	FDateTime Created;
+	IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values State;
+	FDateTime LastReserved;
+	TMap<FString, FString> Labels;
+	TMap<FString, FString> Annotations;
+
+	/** Session manager */
+	FString SessionConfig;
+	TMap<FString, FString> SessionStatus;
+
+	/** State transitions following Ready and time at which the next one happens */
+	TArray<FScriptStep> Script;
+	double NextStepTime;
+
+	/** Injected faults */
+	float LatencyMs;
+	float ErrorRate;
+	int32 ErrorCode;
+	float DropRate;
+
+	TArray<FDelayedResponse> DelayedResponses;
+};
+
+#endif //WITH_SHOOTER_PAYLOAD_MOCK
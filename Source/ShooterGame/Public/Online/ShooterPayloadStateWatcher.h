@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "OpenAPIPayloadLocalApiOperations.h"
+#include "OpenAPIPayloadStatusStateV0.h"
+
+class FShooterIMSClient;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPayloadStateChanged, IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values /*OldState*/, IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values /*NewState*/);
+
+/** Polling schedule of the payload state watcher */
+struct FShooterPayloadPollSchedule
+{
+	/** Interval used right after a state change, a local event or a failed request */
+	float MinInterval = 1.0f;
+
+	/** Factor applied to the interval every time the state is found unchanged */
+	float BackoffMultiplier = 2.0f;
+
+	/** Longest interval for each state, states without an entry are always polled at MinInterval */
+	TMap<IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values, float> MaxIntervals;
+};
+
+/**
+ * Watches the state of the payload through the Payload Local API.
+ *
+ * The state is polled fast while it is likely to change and the interval backs off exponentially, up to a
+ * per state maximum, while it stays the same. Only one request is in flight at a time.
+ */
+class FShooterPayloadStateWatcher : public FTickerObjectBase, public TSharedFromThis<FShooterPayloadStateWatcher>
+{
+public:
+	FShooterPayloadStateWatcher(const TSharedRef<FShooterIMSClient>& InIMSClient, const FShooterPayloadPollSchedule& InSchedule);
+
+	/** Polls again as soon as possible and resets the backoff, to be called on local events that usually precede a state change */
+	void PollNow();
+
+	/** Returns the last known state of the payload */
+	IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values GetState() const { return State; }
+
+	/** Called on the game thread when the state of the payload changes */
+	FOnPayloadStateChanged& OnStateChanged() { return StateChangedEvent; }
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	void Poll();
+	void OnPollComplete(const IMSZeuzAPI::OpenAPIPayloadLocalApi::GetPayloadV0Response& Response);
+
+	/** Returns the longest interval at which the given state is polled */
+	float GetMaxInterval(IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values InState) const;
+
+	TSharedRef<FShooterIMSClient> IMSClient;
+	FShooterPayloadPollSchedule Schedule;
+
+	IMSZeuzAPI::OpenAPIPayloadStatusStateV0::Values State;
+	FOnPayloadStateChanged StateChangedEvent;
+
+	/** Current polling interval and time at which the next poll is due */
+	float CurrentInterval;
+	double NextPollTime;
+
+	bool bPollInFlight;
+
+	/** Set when PollNow is called while a request is in flight */
+	bool bPollRequested;
+};
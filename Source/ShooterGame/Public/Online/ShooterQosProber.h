@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Containers/Queue.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/ArrayReader.h"
+#include <atomic>
+
+class FSocket;
+class FUdpSocketReceiver;
+
+/** Round trip measurement of a session, see FShooterQosProber */
+struct FShooterQosResult
+{
+	/** Median round trip time of the answered probes in milliseconds, negative when none was answered */
+	float LatencyMs = -1.0f;
+
+	/** Ratio of the probes that were not answered before the timeout */
+	float PacketLoss = 1.0f;
+
+	bool IsReachable() const { return LatencyMs >= 0.0f; }
+};
+
+/**
+ * Measures the round trip time and packet loss to a set of UDP endpoints.
+ *
+ * A few small datagrams are sent to every endpoint at once, one sample at a time, and are expected to be echoed back,
+ * see FShooterQosEchoServer. Replies are timestamped as they arrive on the receiver thread, so that the measure does not
+ * depend on the frame rate. The completion callback is executed on the game thread once every probe has been answered
+ * or the timeout has passed since the last sample was sent.
+ */
+class FShooterQosProber : public FTickerObjectBase
+{
+public:
+	FShooterQosProber(int32 InNumSamples = 4, float InSampleIntervalSeconds = 0.05f, float InTimeoutSeconds = 1.0f);
+	virtual ~FShooterQosProber();
+
+	/** Adds an endpoint to probe, given as an IP address. Endpoints that do not parse are reported as unreachable */
+	int32 AddTarget(const FString& Address, int32 Port);
+
+	/** Starts probing, OnComplete receives the results in the order of the targets */
+	void Start(TFunction<void(const TArray<FShooterQosResult>&)>&& InOnComplete);
+
+	/** Stops probing without executing the completion callback */
+	void Cancel();
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+	/** Size of a probe, echoed as is */
+	static const int32 ProbeSize = 12;
+
+private:
+
+	struct FTarget
+	{
+		bool bValid;
+		FIPv4Endpoint Endpoint;
+		TArray<double> SendTimes;
+		TArray<double> RoundTrips;
+	};
+
+	struct FReply
+	{
+		FIPv4Endpoint Sender;
+		uint8 Data[ProbeSize];
+		double ReceiveTime;
+	};
+
+	void SendSample(int32 Sample);
+	void ProcessReplies();
+	bool HasAllReplies() const;
+	void CloseSocket();
+	void Finish();
+
+	int32 NumSamples;
+	float SampleIntervalSeconds;
+	float TimeoutSeconds;
+
+	/** Random value carried by the probes, replies to the probes of another prober are ignored */
+	uint32 Nonce;
+
+	TArray<FTarget> Targets;
+
+	FSocket* Socket;
+	TUniquePtr<FUdpSocketReceiver> Receiver;
+
+	/** Replies timestamped on the receiver thread, consumed on the game thread */
+	TQueue<FReply, EQueueMode::Spsc> Replies;
+
+	double StartTime;
+	int32 NumSamplesSent;
+	bool bStarted;
+	bool bFinished;
+	TFunction<void(const TArray<FShooterQosResult>&)> OnComplete;
+};
+
+/**
+ * Echoes the QoS probes back to their sender, see FShooterQosProber.
+ *
+ * The UDP port of the game is owned by the net driver, which drops datagrams it does not know about, so servers answer
+ * the probes on a port of their own, declared as "QosPort" in the allocation. The server is started with
+ * -QosEchoPort=<port>. It also stands in for game servers locally, with faults injected with:
+ *  -QosEchoLatencyMs=<ms>      delay before every reply
+ *  -QosEchoDropRate=<0..1>     ratio of probes that are not answered
+ *
+ * The same settings can be changed at runtime with the ims.QosEcho.* console commands.
+ */
+class FShooterQosEchoServer : public FTickerObjectBase
+{
+public:
+	/** Starts the echo server if the game was started with -QosEchoPort= */
+	static void Initialize();
+	static void Shutdown();
+
+	/** Returns the running echo server, null when not started */
+	static FShooterQosEchoServer* Get() { return Instance.Get(); }
+
+	/** Listens on the given port, or on a port picked by the system when 0 */
+	FShooterQosEchoServer(uint16 InPort, float InLatencyMs = 0.0f, float InDropRate = 0.0f);
+	virtual ~FShooterQosEchoServer();
+
+	bool IsListening() const { return Socket != nullptr; }
+
+	/** Returns the port listened to */
+	uint16 GetPort() const { return Port; }
+
+	void SetLatencyMs(float InLatencyMs) { LatencyMs = FMath::Max(InLatencyMs, 0.0f); }
+	void SetDropRate(float InDropRate) { DropRate = FMath::Clamp(InDropRate, 0.0f, 1.0f); }
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	struct FDelayedReply
+	{
+		double DueTime;
+		FIPv4Endpoint Receiver;
+		TArray<uint8> Data;
+	};
+
+	void OnDataReceived(const FArrayReaderPtr& Data, const FIPv4Endpoint& Sender);
+
+	/** Registers the ims.QosEcho.* commands, for the server started with the game only */
+	void RegisterConsoleCommands();
+
+	static TUniquePtr<FShooterQosEchoServer> Instance;
+
+	uint16 Port;
+	FSocket* Socket;
+	TUniquePtr<FUdpSocketReceiver> Receiver;
+	TArray<class IConsoleObject*> ConsoleCommands;
+
+	/** Injected faults, read on the receiver thread */
+	std::atomic<float> LatencyMs;
+	std::atomic<float> DropRate;
+
+	/** Only used on the receiver thread */
+	FRandomStream DropStream;
+
+	/** Replies sent from the game thread once their delay has passed */
+	TQueue<FDelayedReply, EQueueMode::Spsc> DelayedReplies;
+};
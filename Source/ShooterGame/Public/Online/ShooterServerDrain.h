@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Drains the server before it exits.
+ *
+ * Steps are run in the order they were added: each step is started once the previous one has completed, so that for
+ * instance the final session status is published after the players have left. The completion delegate is executed
+ * once all steps have completed or when the deadline has passed, whichever happens first.
+ */
+class FShooterServerDrain : public FTickerObjectBase
+{
+public:
+	FShooterServerDrain(const FText& InReason, float InDeadlineSeconds);
+
+	/**
+	 * Adds a step to the drain.
+	 *
+	 * @param Name			name of the step, for logging
+	 * @param Begin			executed when the step starts
+	 * @param IsComplete	polled every frame once the step has started, until it returns true
+	 */
+	void AddStep(const TCHAR* Name, TFunction<void()>&& Begin, TFunction<bool()>&& IsComplete);
+
+	/** Starts draining, OnComplete is executed on the game thread with whether the deadline was reached */
+	void Start(TFunction<void(bool bTimedOut)>&& InOnComplete);
+
+	/** Reason of the drain, as shown to the players */
+	const FText& GetReason() const { return Reason; }
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	struct FStep
+	{
+		const TCHAR* Name;
+		TFunction<void()> Begin;
+		TFunction<bool()> IsComplete;
+	};
+
+	/** Starts the steps that can run, returns true once all of them have completed */
+	bool AdvanceSteps();
+
+	void Finish(bool bTimedOut);
+
+	FText Reason;
+	float DeadlineSeconds;
+
+	TArray<FStep> Steps;
+	int32 CurrentStep;
+	bool bCurrentStepStarted;
+	double StepStartTime;
+
+	double StartTime;
+	bool bStarted;
+	bool bFinished;
+	TFunction<void(bool bTimedOut)> OnComplete;
+};
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "OpenAPIPayloadLocalApiOperations.h"
+
+class FShooterIMSClient;
+
+/** Settings of the server telemetry */
+struct FShooterServerTelemetrySettings
+{
+	/** Length of the aggregation window, telemetry is published at most once per window */
+	float WindowSeconds = 10.0f;
+
+	/** 95th percentile of the game thread frame time above which the load is mid and high */
+	float LoadMidFrameTimeMs = 10.0f;
+	float LoadHighFrameTimeMs = 25.0f;
+};
+
+/** Telemetry aggregated over one window */
+struct FShooterServerTelemetrySnapshot
+{
+	float FrameTimeP50Ms = 0.0f;
+	float FrameTimeP95Ms = 0.0f;
+	float FrameTimeP99Ms = 0.0f;
+	float FrameTimeMaxMs = 0.0f;
+	float NetTickTimeAvgMs = 0.0f;
+	float NetTickTimeMaxMs = 0.0f;
+	uint32 OutBytesPerSecond = 0;
+	int32 NumPlayers = 0;
+	int32 NumBots = 0;
+	uint64 UsedPhysicalMemory = 0;
+};
+
+/**
+ * Samples the performance of the server and publishes it through the Payload Local API.
+ *
+ * Game thread frame time (excluding the time spent waiting for the next frame), net tick time, outgoing bandwidth,
+ * player and bot counts and memory usage are aggregated over a window. At the end of each window they are written
+ * to the "telemetry" annotation of the payload, and the "load" label is set to low, mid or high when it changes.
+ */
+class FShooterServerTelemetry : public FTickerObjectBase, public TSharedFromThis<FShooterServerTelemetry>
+{
+public:
+	FShooterServerTelemetry(const TSharedRef<FShooterIMSClient>& InIMSClient, UWorld* InWorld, const FShooterServerTelemetrySettings& InSettings);
+	virtual ~FShooterServerTelemetry();
+
+	/** Returns the telemetry of the last complete window */
+	const FShooterServerTelemetrySnapshot& GetLastSnapshot() const { return LastSnapshot; }
+
+	/** Publishes the current window without waiting for its end, once the previous write has completed */
+	void Flush();
+
+	/** Returns true when no flush is pending and no write is in flight */
+	bool IsFlushed() const { return !bFlushRequested && !bAnnotationInFlight && !bLabelInFlight; }
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void OnPostTickFlush(float DeltaSeconds);
+
+	/** Aggregates the samples of the window and publishes them */
+	void CompleteWindow();
+	void Publish(const FShooterServerTelemetrySnapshot& Snapshot);
+
+	static const TCHAR* GetLoadLabel(const FShooterServerTelemetrySnapshot& Snapshot, const FShooterServerTelemetrySettings& Settings);
+
+	TSharedRef<FShooterIMSClient> IMSClient;
+	TWeakObjectPtr<UWorld> World;
+	FShooterServerTelemetrySettings Settings;
+
+	FDelegateHandle PostActorTickHandle;
+	FDelegateHandle PostTickFlushHandle;
+
+	/** Samples of the current window */
+	TArray<float> FrameTimesMs;
+	TArray<float> NetTickTimesMs;
+	uint64 OutBytesPerSecondSum;
+	uint32 NumOutBytesSamples;
+	double WindowStartTime;
+
+	/** Time at which the actors finished ticking this frame, the net drivers flush right after */
+	double NetTickStartTime;
+
+	FShooterServerTelemetrySnapshot LastSnapshot;
+
+	/** Last load label acknowledged, the label is only written when it changes */
+	FString PublishedLoadLabel;
+	bool bAnnotationInFlight;
+	bool bLabelInFlight;
+	bool bFlushRequested;
+};
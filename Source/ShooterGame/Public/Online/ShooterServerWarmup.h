@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+
+/** Records the time of the startup milestones of the server, relative to the process start */
+struct FShooterStartupTimeline
+{
+	/** Records a milestone, only the first occurrence of each is kept */
+	void Mark(const TCHAR* Milestone);
+
+	/** Logs all milestones with the time elapsed since the process start and since the previous milestone */
+	void Log() const;
+
+private:
+	TArray<TPair<FString, double>> Milestones;
+};
+
+/**
+ * Warms up the server before it is marked as Ready.
+ *
+ * The packages referenced by the given classes (weapons, effects, behavior trees, ...) are loaded asynchronously in
+ * parallel while the navigation data finishes building. The completion delegate is executed once everything is
+ * warm or when the deadline has passed, whichever happens first.
+ */
+class FShooterServerWarmup : public FTickerObjectBase, public TSharedFromThis<FShooterServerWarmup>
+{
+public:
+	FShooterServerWarmup(UWorld* InWorld, float InDeadlineSeconds);
+	virtual ~FShooterServerWarmup();
+
+	/** Adds the assets referenced by the defaults of the given class, and by the classes it references in turn. Soft references are loaded too. */
+	void AddClassDependencies(UClass* Class);
+
+	/** Starts warming up, OnComplete is executed on the game thread with whether the deadline was reached */
+	void Start(TFunction<void(bool bTimedOut)>&& InOnComplete);
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	void AddObjectDependencies(UObject* Object, int32 Depth);
+	void AddDependency(UObject* Object, int32 Depth);
+	void AddSoftDependency(const FSoftObjectPath& AssetPath);
+
+	bool IsNavigationBuilt() const;
+
+	void Finish(bool bTimedOut);
+
+	TWeakObjectPtr<UWorld> World;
+	float DeadlineSeconds;
+
+	TSet<UObject*> VisitedObjects;
+	TArray<FSoftObjectPath> AssetsToLoad;
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	double StartTime;
+	bool bStarted;
+	bool bFinished;
+	TFunction<void(bool bTimedOut)> OnComplete;
+};
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Typed session config, shared by the client creating the session and the server applying it.
+ *
+ * Only the fields present in the config are set. Decoding streams the JSON tokens straight into the fields, without
+ * building an intermediate FJsonObject, and clamps numeric fields to their valid range. Fields are described by a
+ * single table in ShooterSessionConfig.cpp, adding a field only requires a member and a table entry.
+ */
+struct FShooterSessionConfig
+{
+	TOptional<int32> MaxNumPlayers;
+	TOptional<int32> BotsCount;
+	TOptional<FString> MapName;
+	TOptional<FString> GameMode;
+	TOptional<int32> RoundTime;
+	TOptional<int32> WarmupTime;
+
+	/** Writes the set fields as compact JSON */
+	FString Encode() const;
+
+	/**
+	 * Reads the fields from the JSON config, fields that are not in the config are left unchanged.
+	 *
+	 * @param Json				session config, a single JSON object
+	 * @param OutUnknownKeys	optional, receives the keys that are not part of the schema
+	 * @param OutError			optional, receives why the config could not be read
+	 * @return false if the config is not a valid JSON object or a field has the wrong type
+	 */
+	bool Decode(const FString& Json, TArray<FString>* OutUnknownKeys = nullptr, FString* OutError = nullptr);
+};
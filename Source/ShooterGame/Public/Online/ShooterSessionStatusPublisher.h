@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "OpenAPIBaseModel.h"
+#include "OpenAPISessionManagerLocalApiOperations.h"
+
+class FShooterIMSClient;
+
+/** Counters of the session status publisher */
+struct FShooterSessionStatusPublisherStats
+{
+	/** Number of status updates posted to the Session Manager Local API */
+	uint32 Sent = 0;
+
+	/** Number of publishes skipped because the status matched the last acknowledged one */
+	uint32 Skipped = 0;
+
+	/** Number of SetField or SetFields calls merged into an update that was already waiting to be published */
+	uint32 Merged = 0;
+
+	/** Number of status updates that failed */
+	uint32 Failed = 0;
+};
+
+/**
+ * Publishes the session status to the Session Manager Local API.
+ *
+ * Changed fields are marked dirty and merged for CoalesceWindow seconds before being published. The POST is
+ * skipped when the status matches the last one acknowledged, and at most one request is in flight at a time.
+ */
+class FShooterSessionStatusPublisher : public FTickerObjectBase, public TSharedFromThis<FShooterSessionStatusPublisher>
+{
+public:
+	FShooterSessionStatusPublisher(const TSharedRef<FShooterIMSClient>& InIMSClient, float InCoalesceWindow, const IMSZeuzAPI::HttpRetryParams& InRetryPolicy);
+
+	/** Sets a field of the session status, it is published once the coalesce window has elapsed */
+	void SetField(const FString& Key, const FString& Value);
+
+	/** Sets several fields of the session status at once */
+	void SetFields(const TMap<FString, FString>& Fields);
+
+	/** Publishes the pending changes without waiting for the end of the coalesce window */
+	void Flush();
+
+	/** Returns true when no change is waiting to be published and no request is in flight */
+	bool IsFlushed() const { return !bDirty && !bPublishInFlight; }
+
+	const FShooterSessionStatusPublisherStats& GetStats() const { return Stats; }
+
+	//~ Begin FTickerObjectBase Interface
+	virtual bool Tick(float DeltaTime) override;
+	//~ End FTickerObjectBase Interface
+
+private:
+
+	void Publish();
+	void OnPublishComplete(const IMSZeuzAPI::OpenAPISessionManagerLocalApi::ApiV0SessionManagerStatusPostResponse& Response);
+
+	/** Writes the field to the pending status, returns true if its value changed */
+	bool UpdateField(const FString& Key, const FString& Value);
+
+	/** Schedules a publish at the end of the coalesce window, unless one is already scheduled */
+	void MarkDirty();
+
+	TSharedRef<FShooterIMSClient> IMSClient;
+	float CoalesceWindow;
+	IMSZeuzAPI::HttpRetryParams RetryPolicy;
+
+	/** Latest status, the one in flight and the last one acknowledged by the Session Manager */
+	TMap<FString, FString> PendingStatus;
+	TMap<FString, FString> InFlightStatus;
+	TMap<FString, FString> AcknowledgedStatus;
+
+	bool bDirty;
+	bool bPublishInFlight;
+	double PublishTime;
+
+	FShooterSessionStatusPublisherStats Stats;
+};
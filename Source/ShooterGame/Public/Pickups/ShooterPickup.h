@@ -16,6 +16,9 @@ class AShooterPickup : public AActor
 	/** check if pawn can use this pickup */
 	virtual bool CanBePickedUp(class AShooterCharacter* TestPawn) const;
 
+	/** pause or resume the respawn timer, used while the server is idle */
+	void SetRespawnTimerPaused(bool bPaused);
+
 protected:
 	/** initial setup */
 	virtual void BeginPlay() override;
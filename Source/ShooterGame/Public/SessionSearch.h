@@ -5,6 +5,7 @@
 #include "OpenAPISessionManagerV0Api.h"
 #include "OpenAPIV0Session.h"
 #include "OpenAPIV0Port.h"
+#include "Online/ShooterQosProber.h"
 #include "CoreMinimal.h"
 
 enum SearchState
@@ -19,31 +20,113 @@ enum SearchState
 	Failed
 };
 
-class Session : public IMSSessionManagerAPI::OpenAPIV0Session
+/**
+ * Search result, decoded once from the listed session into the values the browser ranks, filters and shows, so that
+ * neither the ranking nor the rows look the session status up again.
+ */
+struct FSessionRecord
 {
-public:
+	/** Payload id of the session */
+	FString Id;
+
+	/** IP address of the session */
+	FString Address;
+
+	/** Address to travel to, "<ip>:<GamePort>", empty when the session does not declare a game port */
 	FString SessionAddress;
 
-public:
-	Session(IMSSessionManagerAPI::OpenAPIV0Session SessionResponse);
-	~Session();
-
-	const FString GetSessionAddress() const;
-	const FString GetPlayerCount() const;
-	const FString GetFromSessionStatus(FString Key) const;
-	const FString GetGamePhase() const { return GetFromSessionStatus("GamePhase"); }
-	const FString GetMapName() const { return GetFromSessionStatus("MapName"); }
+	/** Port answering the QoS probes: "QosPort" when the session declares one, the game port otherwise */
+	int32 QosPort = 0;
+
+	/** Session status, NAME_None when the session does not tell */
+	FName GamePhase;
+	FName MapName;
+
+	/** Session status, negative when the session does not tell or it does not parse */
+	int32 CurrentNumPlayers = -1;
+	int32 MaxNumPlayers = -1;
+
+	/** Latency and loss measured by the search, see FShooterQosProber */
+	FShooterQosResult Qos;
+
+	/** Rank of the session in the search results, lower first, see SessionSearch::CompleteWithRankedResults */
+	uint64 RankKey = 0;
+
+	FSessionRecord() {}
+	explicit FSessionRecord(const IMSSessionManagerAPI::OpenAPIV0Session& SessionResponse);
+
+	bool HasPlayerCount() const { return CurrentNumPlayers >= 0 && MaxNumPlayers > 0; }
+
+	/** Ratio of the player slots taken, negative when the session status does not tell */
+	float GetFillRatio() const { return HasPlayerCount() ? static_cast<float>(CurrentNumPlayers) / MaxNumPlayers : -1.0f; }
+
+	/** Number of player slots left, negative when the session status does not tell */
+	int32 GetFreeSlots() const { return HasPlayerCount() ? FMath::Max(MaxNumPlayers - CurrentNumPlayers, 0) : -1; }
+
+	/** Whether the session is waiting for its match to start or playing it */
+	bool IsInJoinablePhase() const;
+
+	/** Values as shown in the server list, "Unknown" when the session does not tell */
+	FString GetSessionAddress() const;
+	FString GetGamePhase() const;
+	FString GetMapName() const;
+	FString GetPlayerCount() const;
+	FString GetLatency() const;
 };
 
 class SessionSearch
 {
 public:
 	int32 MaxSearchResults;
-	TArray<Session> SearchResults;
+	TArray<FSessionRecord> SearchResults;
 	SearchState SearchState;
 
+	/** Sessions of the search in progress, the results of the previous search stay valid until it completes */
+	TArray<FSessionRecord> PendingResults;
+
+	/** Incremented whenever the search results are replaced */
+	int32 ResultsRevision;
+
+	/** Sessions listed beyond this number are neither probed nor ranked */
+	int32 MaxProbedSessions;
+
+	/** Sessions losing more probes than this are ranked after the others, whatever their latency */
+	float MaxPacketLoss;
+
+	/** Sessions slower than this are not quick joined, a session is created instead */
+	float MaxQuickJoinLatencyMs;
+
 public:
-	SessionSearch() : MaxSearchResults(8), SearchState(SearchState::NotStarted) {}
+	SessionSearch() : MaxSearchResults(8), SearchState(SearchState::NotStarted), ResultsRevision(0), MaxProbedSessions(64), MaxPacketLoss(0.25f), MaxQuickJoinLatencyMs(150.0f) {}
 	~SessionSearch() {}
 
+	/**
+	 * Replaces the search results with the pending results ordered from the best session to join to the worst, then
+	 * keeps the first MaxSearchResults.
+	 *
+	 * Sessions are ranked by reachability first, then by whether they can be joined (game phase and free slots), then
+	 * by latency in steps of 20 ms so that jitter does not outweigh the rest, then by fill ratio, the fuller
+	 * sessions first, and finally by exact latency. The criteria are packed into the RankKey of each session once, the
+	 * sort only compares integers.
+	 */
+	void CompleteWithRankedResults();
+
+	/** Replaces the search results with the pending results ranked the same way, while more are expected */
+	void PublishRankedResults();
+
+	/**
+	 * Scores a session for quick join, higher is better, negative when it does not fit: not answering the probes,
+	 * losing more than MaxPacketLoss or slower than MaxQuickJoinLatencyMs, without free slots or past its match.
+	 *
+	 * Latency weighs the most, then the fill ratio, so that players are grouped, then the preferred map, and sessions
+	 * waiting for their match to start.
+	 */
+	float GetQuickJoinScore(const FSessionRecord& Result, FName PreferredMapName) const;
+
+	/** Returns the session of the given results with the best quick join score, null when none fits */
+	const FSessionRecord* FindQuickJoinSession(const TArray<FSessionRecord>& Results, const FString& PreferredMapName) const;
+
+private:
+	/** Ranks and truncates the search results, see CompleteWithRankedResults */
+	void RankSearchResults();
 };
\ No newline at end of file
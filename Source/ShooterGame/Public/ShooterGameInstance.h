@@ -11,6 +11,7 @@
 #include "PlayFab.h"
 #include "Core/PlayFabError.h"
 #include "Core/PlayFabClientDataModels.h"
+#include "OpenAPIInstrumentation.h"
 #include "ShooterGameInstance.generated.h"
 
 class FVariantData;
@@ -117,14 +118,14 @@ public:
 	/** Travel directly to the named session */
 	void TravelToSession(const FName& SessionName);
 
-	/** Get the Travel URL for a quick match */
-	static FString GetQuickMatchUrl();
+	/** Initiates the session searching, background searches refresh the results already shown and fail silently */
+	bool FindSessions(ULocalPlayer* PlayerOwner, bool bBackground = false);
 
-	/** Begin a hosted quick match */
-	void BeginHostingQuickMatch();
+	/** Joins the best session for the player right away, or creates one on the preferred map when none fits */
+	bool QuickJoin(ULocalPlayer* PlayerOwner, const FString& PreferredMapName);
 
-	/** Initiates the session searching */
-	bool FindSessions(ULocalPlayer* PlayerOwner);
+	/** Stops the quick join in progress, if any */
+	void CancelQuickJoin();
 
 	/** Sends the game to the specified state. */
 	void GotoState(FName NewState);
@@ -277,6 +278,16 @@ private:
 	FDelegateHandle TravelLocalSessionFailureDelegateHandle;
 	FDelegateHandle OnJoinSessionCompleteDelegateHandle;
 	FDelegateHandle OnSearchSessionsCompleteDelegateHandle;
+
+	/** Whether the session search in progress refreshes results already shown */
+	bool bBackgroundSessionSearch = false;
+	FDelegateHandle OnQuickJoinCompleteDelegateHandle;
+
+	/** Time the quick join in progress started, 0 once the player is in game */
+	double QuickJoinStartTime = 0.0;
+
+	/** Time from the start of a quick join to the player being in game */
+	IMSOpenAPI::FLatencyHistogram QuickJoinTimeToInGame;
 	FDelegateHandle OnStartSessionCompleteDelegateHandle;
 	FDelegateHandle OnEndSessionCompleteDelegateHandle;
 	FDelegateHandle OnDestroySessionCompleteDelegateHandle;
@@ -356,6 +367,9 @@ private:
 	/** Callback which is intended to be called upon finding sessions */
 	void OnSearchSessionsComplete(bool bWasSuccessful);
 
+	/** Callback which is intended to be called upon the completion of a quick join */
+	void OnQuickJoinComplete(bool bWasSuccessful);
+
 	bool LoadFrontEndMap(const FString& MapName);
 
 	/** Travel directly to the named session */
@@ -56,6 +56,9 @@ public class ShooterGame : ModuleRules
 				"PhysicsCore",
 				"GameplayCameras",
 				"Http",
+				"Sockets",
+				"Networking",
+				"IMSOpenAPIRuntime",
 				"IMSZeuzAPI",
 				"IMSSessionManagerAPI",
 			}
@@ -87,6 +90,17 @@ public class ShooterGame : ModuleRules
 			PublicDefinitions.Add("WITH_GAMEPLAY_DEBUGGER=0");
 		}
 		
+		// The in-process Payload Local API stand-in is only needed where a game server can run
+		if (Target.Type == TargetType.Server || Target.Type == TargetType.Editor)
+		{
+			PrivateDependencyModuleNames.Add("HTTPServer");
+			PublicDefinitions.Add("WITH_SHOOTER_PAYLOAD_MOCK=1");
+		}
+		else
+		{
+			PublicDefinitions.Add("WITH_SHOOTER_PAYLOAD_MOCK=0");
+		}
+
 		if (Target.Version.MajorVersion >= 5 || (Target.Version.MajorVersion == 4 && Target.Version.MinorVersion >= 27))
 		{
 			PrivateDependencyModuleNames.Add("GameplayCameras");